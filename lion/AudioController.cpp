@@ -1,5 +1,6 @@
 #include "AudioController.h"
 #include "GameSettings.h"
+#include "LogCategories.h"
 #include <QDebug>
 
 // 1. 初始化音效路径（保留原逻辑，精简调试）
@@ -12,6 +13,18 @@ const QMap<SoundType, QString> initSoundPaths() {
     paths[SoundType::Collect] = "qrc:/sounds/Pick.mp3";
     return paths;
 }
+
+// 各音效同时发声的上限（超出时抢占该音效最早的声部）
+static int maxVoicesFor(SoundType type) {
+    switch (type) {
+    case SoundType::Jump:    return 3;
+    case SoundType::Collect: return 4;
+    case SoundType::Click:   return 2;
+    case SoundType::Float:   return 2;
+    case SoundType::Win:     return 1;
+    }
+    return 1;
+}
 AudioController& AudioController::getInstance(QObject *parent) {
     static AudioController instance(parent);
     return instance;
@@ -25,6 +38,7 @@ AudioController::AudioController(QObject *parent)
     , settings(GameSettings::getInstance())
     , soundEffect(new QSoundEffect)
     , soundPaths(initSoundPaths())
+    , soundMixer(new SoundMixer(this))
 {
     // 绑定 Player 和 AudioOutput（Qt 6 强制要求）
     bgmPlayer->setAudioOutput(bgmAudioOutput);
@@ -38,6 +52,12 @@ AudioController::AudioController(QObject *parent)
     float initVol = settings.musicVolume / 100.0f;
     bgmAudioOutput->setVolume(initVol);  // Qt 6 音量控制入口
     soundEffect->setVolume(settings.soundVolume / 100.0f);
+    soundMixer->setVolume(settings.soundVolume / 100.0f);
+
+    // 启动时把所有音效预解码为PCM，之后播放不再打开文件
+    for (auto it = soundPaths.constBegin(); it != soundPaths.constEnd(); ++it) {
+        soundMixer->loadClip(static_cast<int>(it.key()), QUrl(it.value()), maxVoicesFor(it.key()));
+    }
 
     // // 音效线程初始化（保留原逻辑）
     // soundEffect->moveToThread(&soundThread);
@@ -57,6 +77,8 @@ AudioController::~AudioController() {
     bgmPlayer->stop();
     bgmPlayer->setSource(QUrl());  // 清除媒体源，触发底层接口释放
     soundEffect->stop();
+    delete soundMixer;  // 停止混音输出并结束音频线程
+    soundMixer = nullptr;
 
     // 2. 断开所有信号连接（防止析构时触发槽函数）
     bgmPlayer->disconnect();
@@ -85,20 +107,20 @@ AudioController::~AudioController() {
 void AudioController::playBackgroundMusic() {
     // 边界检查：BGM列表为空则返回
     if (bgmFiles.isEmpty()|| !settings.musicEnabled) {
-        qDebug() << "[Audio] BGM列表为空或已禁用";
+        qCDebug(lcAudio) << "BGM列表为空或已禁用";
         return;
     }
     // 设置当前BGM源并播放（1行代码完成核心操作）
     bgmPlayer->setSource(QUrl(bgmFiles[currentBGMIndex]));
     bgmPlayer->play();
-    qDebug() << "[Audio] 播放BGM：" << bgmFiles[currentBGMIndex];
+    qCDebug(lcAudio) << "播放BGM：" << bgmFiles[currentBGMIndex];
 }
 
 // 5. 简化后的BGM停止逻辑
 void AudioController::stopBackgroundMusic() {
     bgmPlayer->stop();
     currentBGMIndex = 0;  // 停止后重置索引（下次播放从第一首开始）
-    qDebug() << "[Audio] 停止BGM";
+    qCDebug(lcAudio) << "停止BGM";
 }
 
 // 6. 新增：BGM结束自动切换（抽离逻辑，代码更清晰）
@@ -117,32 +139,38 @@ void AudioController::setBgmVolume(int volume) {
     bgmAudioOutput->setVolume(volume / 100.0f);
     // 同步更新配置（确保重启后生效）
     settings.musicVolume = volume;
-    qDebug() << "[Audio] BGM音量更新为：" << volume;
+    qCDebug(lcAudio) << "BGM音量更新为：" << volume;
 }
 void AudioController::setSoundVolume(int volume) {
     // 范围限制
     volume = qBound(0, volume, 100);
     // 更新音效音量
     soundEffect->setVolume(volume / 100.0f);
+    soundMixer->setVolume(volume / 100.0f);
     // 同步更新配置
     settings.soundVolume = volume;
-    qDebug() << "[Audio] 音效音量更新为：" << volume;
+    qCDebug(lcAudio) << "音效音量更新为：" << volume;
 }
 
 // 8. 音效播放逻辑（保留原逻辑，无修改）
 void AudioController::playSound(SoundType type) {
     if (!settings.soundEnabled || !soundPaths.contains(type)) {
-        qDebug() << "[Audio] 音效禁用或类型无效";
+        LJ_HOT_DEBUG(lcAudioPlay) << "音效禁用或类型无效";
         return;
     }
     emit triggerPlaySound(type);
 }
 
 void AudioController::onPlaySound(SoundType type) {
+    // 混音器可用时直接触发声部，与正在播放的音效叠加
+    if (soundMixer->play(static_cast<int>(type))) {
+        return;
+    }
+
     soundEffect->stop();
     const QString &path = soundPaths[type];
     soundEffect->setSource(QUrl(path));
     soundEffect->setVolume(settings.soundVolume / 100.0f);
     soundEffect->play();
-    qDebug() << "[Audio] 播放音效：" << path;
+    LJ_HOT_DEBUG(lcAudioPlay) << "播放音效：" << path;
 }
@@ -7,6 +7,7 @@
 #include <QThread>
 #include <QUrl>
 #include <QMap>
+#include "SoundMixer.h"
 class GameSettings;
 
 enum class SoundType {
@@ -42,9 +43,10 @@ private:
 
     // 音效相关（保留原逻辑，不受BGM简化影响）
     QThread soundThread;
-    QSoundEffect *soundEffect;
+    QSoundEffect *soundEffect;     // 混音器不可用或音效尚未解码完成时的后备播放
     GameSettings &settings;
     QMap<SoundType, QString> soundPaths;
+    SoundMixer *soundMixer;        // 预解码、多声部的低延迟音效混音器
 
 private slots:
     void onPlaySound(SoundType type);
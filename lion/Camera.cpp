@@ -0,0 +1,39 @@
+/**
+ * @file Camera.cpp
+ * @brief 跟随玩家的滚动摄像机实现
+ * @author 开发团队
+ * @date 2025-11-29
+ */
+
+#include "Camera.h"
+#include <QtGlobal>
+#include <cmath>
+
+Camera::Camera(const QSizeF& viewportSize)
+    : viewport_size(viewportSize)
+    , world_size(viewportSize)
+    , position(0, 0)
+{
+}
+
+void Camera::setViewportSize(const QSizeF& size)
+{
+    viewport_size = size;
+    centerOn(getViewRect().center());
+}
+
+void Camera::setWorldSize(const QSizeF& size)
+{
+    world_size = size;
+    centerOn(getViewRect().center());
+}
+
+void Camera::centerOn(const QPointF& focus)
+{
+    // 世界小于视口的方向固定在原点
+    const qreal maxX = qMax<qreal>(0.0, world_size.width() - viewport_size.width());
+    const qreal maxY = qMax<qreal>(0.0, world_size.height() - viewport_size.height());
+    const qreal x = qBound<qreal>(0.0, focus.x() - viewport_size.width() / 2.0, maxX);
+    const qreal y = qBound<qreal>(0.0, focus.y() - viewport_size.height() / 2.0, maxY);
+    position = QPointF(std::round(x), std::round(y));
+}
@@ -0,0 +1,68 @@
+/**
+ * @file Camera.h
+ * @brief 跟随玩家的滚动摄像机
+ * @author 开发团队
+ * @date 2025-11-29
+ * @version 1.0.0
+ */
+
+#ifndef CAMERA_H
+#define CAMERA_H
+
+#include <QPointF>
+#include <QSizeF>
+#include <QRectF>
+
+/**
+ * @class Camera
+ * @brief 二维摄像机
+ *
+ * 以焦点为中心取景，并限制在世界范围内；世界小于视口的方向固定在原点，
+ * 单屏关卡因此与没有摄像机时完全一致。
+ */
+class Camera
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param viewportSize 视口大小（像素）
+     */
+    explicit Camera(const QSizeF& viewportSize = QSizeF());
+
+    /**
+     * @brief 设置视口大小
+     * @param size 视口大小（像素）
+     */
+    void setViewportSize(const QSizeF& size);
+
+    /**
+     * @brief 设置世界大小
+     * @param size 世界大小（像素）
+     */
+    void setWorldSize(const QSizeF& size);
+
+    /**
+     * @brief 以焦点为中心取景（限制在世界范围内）
+     * @param focus 焦点（世界坐标）
+     */
+    void centerOn(const QPointF& focus);
+
+    /**
+     * @brief 获取视口左上角的世界坐标（取整，避免贴图在半像素处发虚）
+     * @return QPointF 视口位置
+     */
+    QPointF getPosition() const { return position; }
+
+    /**
+     * @brief 获取视口覆盖的世界矩形
+     * @return QRectF 可见区域（世界坐标）
+     */
+    QRectF getViewRect() const { return QRectF(position, viewport_size); }
+
+private:
+    QSizeF viewport_size;   ///< 视口大小
+    QSizeF world_size;      ///< 世界大小
+    QPointF position;       ///< 视口左上角（世界坐标）
+};
+
+#endif // CAMERA_H
@@ -0,0 +1,71 @@
+/**
+ * @file CollisionGrid.cpp
+ * @brief 按位压缩的实心方块碰撞网格实现
+ * @author 开发团队
+ * @date 2025-11-28
+ */
+
+#include "CollisionGrid.h"
+
+CollisionGrid::CollisionGrid(int width, int height)
+    : grid_width(0)
+    , grid_height(0)
+    , words_per_row(0)
+{
+    resize(width, height);
+}
+
+void CollisionGrid::resize(int width, int height)
+{
+    grid_width = qMax(0, width);
+    grid_height = qMax(0, height);
+    words_per_row = (grid_width + 2 + 63) / 64;
+    bits.fill(0, (grid_height + 2) * words_per_row);
+}
+
+void CollisionGrid::clear()
+{
+    bits.fill(0);
+}
+
+void CollisionGrid::setSolid(int col, int row, bool solid)
+{
+    if (col < 0 || col >= grid_width || row < 0 || row >= grid_height) return;
+
+    const int c = col + 1;
+    const quint64 mask = quint64(1) << (c & 63);
+    quint64& word = bits[wordIndex(row + 1, c)];
+    if (solid) {
+        word |= mask;
+    } else {
+        word &= ~mask;
+    }
+}
+
+bool CollisionGrid::anySolidInRow(int row, int colBegin, int colEnd) const
+{
+    const int first = clampCol(colBegin) + 1;
+    const int last = clampCol(colEnd) + 1;
+    if (first > last) return false;
+
+    const int base = wordIndex(clampRow(row) + 1, 0);
+    const int firstWord = first >> 6;
+    const int lastWord = last >> 6;
+    for (int w = firstWord; w <= lastWord; ++w) {
+        quint64 mask = ~quint64(0);
+        if (w == firstWord) mask &= ~quint64(0) << (first & 63);
+        if (w == lastWord) mask &= ~quint64(0) >> (63 - (last & 63));
+        if (bits[base + w] & mask) return true;
+    }
+    return false;
+}
+
+bool CollisionGrid::anySolidInRect(int colBegin, int rowBegin, int colEnd, int rowEnd) const
+{
+    const int firstRow = clampRow(rowBegin);
+    const int lastRow = clampRow(rowEnd);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        if (anySolidInRow(row, colBegin, colEnd)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file CollisionGrid.h
+ * @brief 按位压缩的实心方块碰撞网格
+ * @author 开发团队
+ * @date 2025-11-28
+ * @version 1.0.0
+ */
+
+#ifndef COLLISIONGRID_H
+#define COLLISIONGRID_H
+
+#include <QVector>
+#include "Config.h"
+
+/**
+ * @class CollisionGrid
+ * @brief 实心方块碰撞网格
+ *
+ * 行优先存储，每格1位。网格四周各有一圈哨兵格（恒为空），任意越界坐标都先被
+ * 收拢到哨兵圈上，因此查询不需要逐项做边界判断，越界一律视为空。
+ */
+class CollisionGrid
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param width 宽度（格子数）
+     * @param height 高度（格子数）
+     */
+    explicit CollisionGrid(int width = GRID_WIDTH, int height = GRID_HEIGHT);
+
+    /**
+     * @brief 重新设置尺寸并清空
+     * @param width 宽度（格子数）
+     * @param height 高度（格子数）
+     */
+    void resize(int width, int height);
+
+    /**
+     * @brief 清空所有实心格
+     */
+    void clear();
+
+    /**
+     * @brief 设置格子是否为实心（越界忽略）
+     * @param col 列
+     * @param row 行
+     * @param solid 是否实心
+     */
+    void setSolid(int col, int row, bool solid);
+
+    /**
+     * @brief 查询格子是否为实心（越界视为空）
+     * @param col 列
+     * @param row 行
+     * @return bool 是否实心
+     */
+    bool isSolid(int col, int row) const {
+        const int c = clampCol(col) + 1;
+        return (bits[wordIndex(clampRow(row) + 1, c)] >> (c & 63)) & 1;
+    }
+
+    /**
+     * @brief 查询一行中 [colBegin, colEnd] 列是否有任何实心格（越界部分视为空）
+     * @param row 行
+     * @param colBegin 起始列（含）
+     * @param colEnd 结束列（含）
+     * @return bool 是否有实心格
+     */
+    bool anySolidInRow(int row, int colBegin, int colEnd) const;
+
+    /**
+     * @brief 查询矩形格子范围 [colBegin, colEnd] x [rowBegin, rowEnd] 内是否有实心格
+     * @return bool 是否有实心格
+     */
+    bool anySolidInRect(int colBegin, int rowBegin, int colEnd, int rowEnd) const;
+
+    int getWidth() const { return grid_width; }
+    int getHeight() const { return grid_height; }
+
+private:
+    // 越界坐标收拢到哨兵格（-1或width/height）上
+    int clampCol(int col) const { return qBound(-1, col, grid_width); }
+    int clampRow(int row) const { return qBound(-1, row, grid_height); }
+
+    // 含哨兵的存储坐标 -> 字下标
+    int wordIndex(int storedRow, int storedCol) const {
+        return storedRow * words_per_row + (storedCol >> 6);
+    }
+
+    int grid_width;             ///< 宽度（不含哨兵）
+    int grid_height;            ///< 高度（不含哨兵）
+    int words_per_row;          ///< 每行（含哨兵）占用的64位字数
+    QVector<quint64> bits;      ///< 行优先位图，第(row+1)行第(col+1)位对应格子(col, row)
+};
+
+#endif // COLLISIONGRID_H
@@ -81,6 +81,10 @@ inline QString getSettingsDirectory() {
 #define HEIGHT (2*W+1)
 //16ms刷新一次 (约60FPS)
 #define GAME_TICK 16
+//固定步长模拟：单次定时器唤醒最多追赶的tick数，超出的积压直接丢弃
+#define MAX_CATCHUP_TICKS 5
+//箭矢池容量（同时存在的箭矢上限，超出时新箭矢被丢弃）
+#define MAX_PROJECTILES 4096
 //重力加速度 (像素/秒²，适应真实物理计算)
 #define G 800.0
 #define B0 32  //方块边长
@@ -89,6 +93,12 @@ inline QString getSettingsDirectory() {
 //关卡编辑器网格大小
 #define GRID_WIDTH (XSIZE / B0)    //水平格子数：40
 #define GRID_HEIGHT (YSIZE / B0)   //垂直格子数：22
+//世界分块边长（格子数）：关卡网格按分块存储，渲染与模拟只处理视口附近的分块
+#define CHUNK_TILES 16
+//静态图层分块缓存上限（块数），超出后按最近最少使用淘汰
+#define STATIC_CHUNK_CACHE 24
+//同时驻留内存的完整关卡数上限，超出后按最近最少使用淘汰（关卡目录只保存元数据）
+#define LEVEL_CACHE_SIZE 4
 #define TITLE "Lion Jump"
 #define BG_SPEED 1
 #define BACK_GROUND1 ":/images/background.png"
@@ -0,0 +1,98 @@
+/**
+ * @file ElementStore.cpp
+ * @brief 游戏元素组件存储实现
+ * @author 开发团队
+ * @date 2025-11-29
+ */
+
+#include "ElementStore.h"
+#include <QHash>
+#include <QPair>
+
+void ElementStore::build(const QVector<GameElement>& elements)
+{
+    const int count = elements.size();
+    transforms.resize(count);
+    hazards.reset(count);
+    collectibles.reset(count);
+    movers.reset(count);
+    triggers.reset(count);
+    emitters.reset(count);
+
+    // 旧逻辑按（位置, 类型）判断是否已收集，重叠的相同元素要共用标记位才能保持一致
+    QHash<QPair<int, QPair<qreal, qreal>>, int> slotOfKey;
+    auto collectSlot = [&slotOfKey](const GameElement& element) {
+        const auto key = qMakePair(static_cast<int>(element.element_type),
+                                   qMakePair(element.position.x(), element.position.y()));
+        auto it = slotOfKey.constFind(key);
+        if (it == slotOfKey.constEnd()) {
+            it = slotOfKey.insert(key, slotOfKey.size());
+        }
+        return it.value();
+    };
+
+    for (EntityId entity = 0; entity < count; ++entity) {
+        const GameElement& element = elements[entity];
+        transforms[entity].rect = QRectF(element.position.x(), element.position.y(),
+                                         element.size.x(), element.size.y());
+
+        // 元素类型只在这里决定组件组合
+        switch (element.element_type) {
+        case GameElementType::Vegetable: {
+            CollectibleComponent& item = collectibles.add(entity);
+            item.kind = CollectibleKind::Item;
+            item.objective = "collect_vegetables";
+            item.slot = collectSlot(element);
+            break;
+        }
+        case GameElementType::LevelExit: {
+            CollectibleComponent& exit = collectibles.add(entity);
+            exit.kind = CollectibleKind::Exit;
+            exit.objective = "reach_exit";
+            exit.slot = collectSlot(element);
+            break;
+        }
+        case GameElementType::Water: {
+            HazardComponent& water = hazards.add(entity);
+            water.effect = HazardEffect::Slow;
+            water.speed_scale = 0.5;    // 进入水域后移动速度减半
+            break;
+        }
+        case GameElementType::Lava:
+            hazards.add(entity).effect = HazardEffect::Lethal;
+            break;
+        case GameElementType::HorizontalPlatform:
+        case GameElementType::VerticalPlatform:
+            movers.add(entity).horizontal = element.element_type == GameElementType::HorizontalPlatform;
+            break;
+        case GameElementType::Switch: {
+            TriggerComponent& trigger = triggers.add(entity);
+            trigger.role = TriggerRole::Switch;
+            trigger.momentary = element.trigger.momentary;
+            break;
+        }
+        case GameElementType::Door:
+            triggers.add(entity).role = TriggerRole::Door;
+            break;
+        case GameElementType::ArrowTrap: {
+            // 长度2格、厚度8像素的箭矢，约3格/秒
+            EmitterComponent& emitter = emitters.add(entity);
+            const float speed = 6.0f;
+            emitter.width = 2 * B0;
+            emitter.height = 8.0f;
+            switch (element.arrow.direction) {
+            case ArrowDirection::Right: emitter.vx = speed;  break;
+            case ArrowDirection::Left:  emitter.vx = -speed; break;
+            case ArrowDirection::Up:    emitter.vy = -speed; emitter.width = 8.0f; emitter.height = 2 * B0; break;
+            case ArrowDirection::Down:  emitter.vy = speed;  emitter.width = 8.0f; emitter.height = 2 * B0; break;
+            }
+            emitter.origin = element.position + QPointF(element.size.x() / 2, element.size.y() / 2);
+            emitter.interval = element.arrow.fire_interval;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    collect_slot_count = slotOfKey.size();
+}
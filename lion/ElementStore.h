@@ -0,0 +1,187 @@
+/**
+ * @file ElementStore.h
+ * @brief 游戏元素的组件存储：按组件类型分开的稠密数组
+ * @author 开发团队
+ * @date 2025-11-29
+ * @version 1.0.0
+ */
+
+#ifndef ELEMENTSTORE_H
+#define ELEMENTSTORE_H
+
+#include <QVector>
+#include <QRectF>
+#include <QPointF>
+#include "LevelData.h"
+
+/// 实体id：即关卡中的游戏元素索引，在关卡运行期间不变
+using EntityId = int;
+
+/**
+ * @class ComponentArray
+ * @brief 单一组件类型的稀疏集合
+ *
+ * 组件紧密排列在 dense 数组中（按实体id升序加入，遍历顺序与元素顺序一致），
+ * entities 记录每个组件所属的实体，sparse 按实体id反查组件位置（-1为无）。
+ * 系统只遍历自己需要的组件数组，不必扫描全部元素再按类型分支。
+ */
+template <typename T>
+class ComponentArray
+{
+public:
+    /**
+     * @brief 清空组件并为 entityCount 个实体准备反查表
+     */
+    void reset(int entityCount)
+    {
+        dense.clear();
+        entities.clear();
+        sparse.fill(-1, entityCount);
+    }
+
+    /**
+     * @brief 为实体添加组件
+     * @return T& 新组件
+     */
+    T& add(EntityId entity, const T& component = T())
+    {
+        sparse[entity] = dense.size();
+        entities.append(entity);
+        dense.append(component);
+        return dense.last();
+    }
+
+    bool has(EntityId entity) const
+    {
+        return entity >= 0 && entity < sparse.size() && sparse[entity] >= 0;
+    }
+
+    /**
+     * @brief 查找实体的组件
+     * @return 组件指针，实体没有该组件时为nullptr
+     */
+    const T* find(EntityId entity) const { return has(entity) ? &dense[sparse[entity]] : nullptr; }
+    T* find(EntityId entity) { return has(entity) ? &dense[sparse[entity]] : nullptr; }
+
+    int size() const { return dense.size(); }
+    bool isEmpty() const { return dense.isEmpty(); }
+
+    /// 第 index 个组件与其所属实体（按加入顺序）
+    const T& at(int index) const { return dense[index]; }
+    T& at(int index) { return dense[index]; }
+    EntityId entityAt(int index) const { return entities[index]; }
+
+    /// 组件在 dense 数组中的位置（-1为无）
+    int indexOf(EntityId entity) const { return has(entity) ? sparse[entity] : -1; }
+
+private:
+    QVector<T> dense;               ///< 组件数据
+    QVector<EntityId> entities;     ///< 组件所属实体
+    QVector<int> sparse;            ///< 实体id -> dense下标
+};
+
+/**
+ * @enum HazardEffect
+ * @brief 危险区域对玩家的作用
+ */
+enum class HazardEffect {
+    Lethal,     ///< 触碰即死亡（岩浆）
+    Slow        ///< 处于其中时减速（水）
+};
+
+/**
+ * @enum CollectibleKind
+ * @brief 可收集物的种类
+ */
+enum class CollectibleKind {
+    Item,       ///< 普通收集物（青菜）
+    Exit        ///< 出口：目标完成后才能到达，到达即通关
+};
+
+/**
+ * @enum TriggerRole
+ * @brief 开关门中的角色
+ */
+enum class TriggerRole {
+    Switch,
+    Door
+};
+
+/// 变换：元素占据的矩形（所有实体都有，按实体id直接索引）
+struct TransformComponent {
+    QRectF rect;
+};
+
+/// 危险区域
+struct HazardComponent {
+    HazardEffect effect = HazardEffect::Lethal;
+    double speed_scale = 1.0;       ///< Slow 时的移动速度倍率
+};
+
+/// 可收集物
+struct CollectibleComponent {
+    CollectibleKind kind = CollectibleKind::Item;
+    QString objective;              ///< 收集时推进的关卡目标类型
+    int slot = 0;                   ///< 收集标记位（位置与种类相同的重叠元素共用）
+};
+
+/// 移动平台（运行状态在 SimulationWorld::moving_platforms 中，下标与组件顺序一致）
+struct MoverComponent {
+    bool horizontal = true;         ///< 水平平台（否则为垂直平台，只影响贴图）
+};
+
+/// 开关门
+struct TriggerComponent {
+    TriggerRole role = TriggerRole::Switch;
+    bool momentary = false;         ///< 开关：压力板（玩家离开后复位），否则触发后保持
+    int node = -1;                  ///< 开关：对应的源节点；门：驱动它的节点（-1为未接入触发图）
+    bool active = false;            ///< 开关：是否按下；门：是否打开
+};
+
+/// 发射器（箭机关），发射参数在加载时算好
+struct EmitterComponent {
+    QPointF origin;                 ///< 发射点（元素中心）
+    float vx = 0.0f;                ///< 箭矢每tick位移
+    float vy = 0.0f;
+    float width = 0.0f;             ///< 箭矢大小
+    float height = 0.0f;
+    int interval = 60;              ///< 发射间隔（tick）
+    bool enabled = true;            ///< 被触发图关闭时不发射
+};
+
+/**
+ * @class ElementStore
+ * @brief 关卡元素的运行时组件视图
+ *
+ * 关卡加载后由 GameElement 列表构建一次：元素类型只在 build() 中决定实体
+ * 拥有哪些组件，各系统之后按组件遍历，新增元素类型只需在 build() 中组合
+ * 已有组件。GameElement 仍是编辑与存储格式，组件中不再携带纹理路径与
+ * 原始properties。
+ */
+class ElementStore
+{
+public:
+    /**
+     * @brief 由关卡元素构建全部组件
+     * @param elements 关卡元素（实体id即其下标）
+     */
+    void build(const QVector<GameElement>& elements);
+
+    /**
+     * @brief 清空全部组件
+     */
+    void clear() { build(QVector<GameElement>()); }
+
+    int entityCount() const { return transforms.size(); }
+    const QRectF& rectOf(EntityId entity) const { return transforms[entity].rect; }
+
+    QVector<TransformComponent> transforms;         ///< 变换（按实体id索引）
+    ComponentArray<HazardComponent> hazards;        ///< 危险区域
+    ComponentArray<CollectibleComponent> collectibles;  ///< 可收集物
+    ComponentArray<MoverComponent> movers;          ///< 移动平台
+    ComponentArray<TriggerComponent> triggers;      ///< 开关门
+    ComponentArray<EmitterComponent> emitters;      ///< 发射器
+    int collect_slot_count = 0;                     ///< 收集标记位数
+};
+
+#endif // ELEMENTSTORE_H
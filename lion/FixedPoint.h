@@ -0,0 +1,130 @@
+/**
+ * @file FixedPoint.h
+ * @brief 24.8定点数：模拟中玩家与移动平台的位置、速度
+ * @author 开发团队
+ * @date 2025-11-29
+ * @version 1.0.0
+ */
+
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <QtGlobal>
+#include <QPointF>
+#include <QRectF>
+#include <cmath>
+
+/**
+ * @namespace Fx
+ * @brief 定点数运算
+ *
+ * 数值以像素为单位，低8位为小数（1/256像素）。tick内的积分只做整数加减，
+ * 结果与编译器、浮点模式无关，回放与状态哈希逐位一致。只在关卡加载时
+ * 由 fromReal() 转换配置中的浮点数，只在碰撞与渲染时转回浮点。
+ */
+namespace Fx {
+
+using Fixed = qint32;
+
+constexpr int SHIFT = 8;                ///< 小数位数
+constexpr Fixed ONE = 1 << SHIFT;       ///< 1像素
+
+/**
+ * @brief 整数像素转定点
+ */
+constexpr Fixed fromInt(int pixels) { return pixels * ONE; }
+
+/**
+ * @brief 定点转整数像素（向下取整，负数同样向负无穷取整）
+ */
+constexpr int floorToInt(Fixed value)
+{
+    return value >= 0 ? value / ONE : -((-value + ONE - 1) / ONE);
+}
+
+/**
+ * @brief 定点转浮点（碰撞与渲染用）
+ */
+constexpr double toReal(Fixed value) { return value / double(ONE); }
+
+/**
+ * @brief 浮点转定点（四舍五入；只用于加载配置，不在tick内调用）
+ */
+inline Fixed fromReal(double value) { return static_cast<Fixed>(std::lround(value * ONE)); }
+
+/**
+ * @brief 整数平方根（向下取整），用于编译期求起跳速度
+ */
+constexpr qint64 isqrt(qint64 value)
+{
+    qint64 root = 0;
+    qint64 bit = qint64(1) << 62;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/**
+ * @struct Point
+ * @brief 定点二维坐标
+ */
+struct Point {
+    Fixed x = 0;
+    Fixed y = 0;
+
+    constexpr Point() = default;
+    constexpr Point(Fixed x, Fixed y) : x(x), y(y) {}
+
+    static Point fromPointF(const QPointF& p) { return Point(fromReal(p.x()), fromReal(p.y())); }
+    QPointF toPointF() const { return QPointF(toReal(x), toReal(y)); }
+
+    constexpr Point operator+(const Point& o) const { return Point(x + o.x, y + o.y); }
+    constexpr Point operator-(const Point& o) const { return Point(x - o.x, y - o.y); }
+    constexpr Point operator-() const { return Point(-x, -y); }
+    Point& operator+=(const Point& o) { x += o.x; y += o.y; return *this; }
+    constexpr bool operator==(const Point& o) const { return x == o.x && y == o.y; }
+    constexpr bool operator!=(const Point& o) const { return !(*this == o); }
+    constexpr bool isNull() const { return x == 0 && y == 0; }
+};
+
+/**
+ * @struct Rect
+ * @brief 定点矩形（左、上、右、下边界）
+ */
+struct Rect {
+    Fixed left = 0;
+    Fixed top = 0;
+    Fixed right = 0;
+    Fixed bottom = 0;
+
+    constexpr Rect() = default;
+    constexpr Rect(Fixed left, Fixed top, Fixed right, Fixed bottom)
+        : left(left), top(top), right(right), bottom(bottom) {}
+
+    /// 由位置与大小构造
+    static constexpr Rect fromPosSize(Point pos, Fixed width, Fixed height)
+    {
+        return Rect(pos.x, pos.y, pos.x + width, pos.y + height);
+    }
+    static Rect fromRectF(const QRectF& r)
+    {
+        return Rect(fromReal(r.left()), fromReal(r.top()), fromReal(r.right()), fromReal(r.bottom()));
+    }
+
+    constexpr Rect adjusted(Fixed dl, Fixed dt, Fixed dr, Fixed db) const
+    {
+        return Rect(left + dl, top + dt, right + dr, bottom + db);
+    }
+};
+
+} // namespace Fx
+
+#endif // FIXEDPOINT_H
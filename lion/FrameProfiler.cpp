@@ -0,0 +1,187 @@
+/**
+ * @file FrameProfiler.cpp
+ * @brief 帧耗时分析器实现
+ * @author 开发团队
+ * @date 2025-11-28
+ */
+
+#include "FrameProfiler.h"
+#include "LogCategories.h"
+#include <QCoreApplication>
+#include <QPainter>
+#include <QFontDatabase>
+#include <algorithm>
+
+static_assert(int(FrameProfiler::StageElements) + 1 == int(SimulationWorld::StageCount),
+              "FrameProfiler 的模拟阶段必须与 SimulationWorld::Stage 对应");
+
+FrameProfiler::Scope::Scope(Stage stage)
+    : stage(stage)
+    , running(FrameProfiler::getInstance().isEnabled())
+{
+    if (running) timer.start();
+}
+
+void FrameProfiler::Scope::stop()
+{
+    if (!running) return;
+    running = false;
+    FrameProfiler::getInstance().addSample(stage, timer.nsecsElapsed());
+}
+
+FrameProfiler& FrameProfiler::getInstance()
+{
+    static FrameProfiler instance;
+    return instance;
+}
+
+FrameProfiler::FrameProfiler()
+    : overlay_visible(false)
+    , window_pos(0)
+    , window_filled(0)
+{
+    for (int i = 0; i < StageCount; ++i) {
+        tick_ns[i] = 0;
+        window[i].resize(WINDOW_TICKS);
+    }
+
+    // 退出前写完CSV缓冲
+    if (QCoreApplication::instance()) {
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                         [this]() { closeCsv(); });
+    }
+}
+
+bool FrameProfiler::openCsv(const QString& path)
+{
+    closeCsv();
+    csv_file.setFileName(path);
+    if (!csv_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qCDebug(lcRender) << "无法创建耗时统计文件：" << path;
+        return false;
+    }
+    csv_stream.setDevice(&csv_file);
+    csv_stream << "tick";
+    for (int i = 0; i < StageCount; ++i) {
+        csv_stream << ',' << stageName(static_cast<Stage>(i));
+    }
+    csv_stream << '\n';
+    return true;
+}
+
+void FrameProfiler::closeCsv()
+{
+    if (!csv_file.isOpen()) return;
+    csv_stream.flush();
+    csv_stream.setDevice(nullptr);
+    csv_file.close();
+}
+
+void FrameProfiler::collectWorldStages(SimulationWorld& world)
+{
+    for (int i = 0; i < SimulationWorld::StageCount; ++i) {
+        tick_ns[i] += world.getStageTimeNs(static_cast<SimulationWorld::Stage>(i));
+    }
+    world.resetStageTimes();
+}
+
+void FrameProfiler::commitTick(quint32 tick)
+{
+    if (!isEnabled()) return;
+
+    for (int i = 0; i < StageCount; ++i) {
+        window[i][window_pos] = tick_ns[i];
+    }
+    window_pos = (window_pos + 1) % WINDOW_TICKS;
+    window_filled = qMin(window_filled + 1, WINDOW_TICKS);
+
+    if (csv_file.isOpen()) {
+        csv_stream << tick;
+        for (int i = 0; i < StageCount; ++i) {
+            csv_stream << ',' << tick_ns[i];
+        }
+        csv_stream << '\n';
+    }
+
+    for (int i = 0; i < StageCount; ++i) {
+        tick_ns[i] = 0;
+    }
+}
+
+FrameProfiler::StageStats FrameProfiler::computeStats(Stage stage) const
+{
+    StageStats stats;
+    if (window_filled == 0) return stats;
+
+    QVector<qint64> sorted(window[stage].constBegin(), window[stage].constBegin() + window_filled);
+    std::sort(sorted.begin(), sorted.end());
+    auto percentile = [&](int p) {
+        const int rank = (window_filled * p + 99) / 100;   // 最近秩法
+        return sorted[qMax(rank, 1) - 1];
+    };
+    stats.p50 = percentile(50);
+    stats.p95 = percentile(95);
+    stats.p99 = percentile(99);
+    stats.max = sorted.last();
+    return stats;
+}
+
+void FrameProfiler::drawOverlay(QPainter& painter, const QRect& area)
+{
+    // 排序开销随窗口增长，统计只定期刷新
+    if (!overlay_refresh.isValid() || overlay_refresh.elapsed() >= OVERLAY_REFRESH_MS) {
+        for (int i = 0; i < StageCount; ++i) {
+            overlay_stats[i] = computeStats(static_cast<Stage>(i));
+        }
+        overlay_refresh.start();
+    }
+
+    QFont font = QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    font.setPointSize(9);
+    const QFontMetrics metrics(font);
+    const int lineHeight = metrics.height();
+    const int padding = 8;
+
+    QStringList lines;
+    lines << QString("%1%2%3%4%5").arg("stage (us)", -12).arg("p50", 8).arg("p95", 8).arg("p99", 8).arg("max", 8);
+    auto us = [](qint64 ns) { return QString::number(ns / 1000.0, 'f', 1); };
+    for (int i = 0; i < StageCount; ++i) {
+        const StageStats& s = overlay_stats[i];
+        lines << QString("%1%2%3%4%5").arg(stageName(static_cast<Stage>(i)), -12)
+                     .arg(us(s.p50), 8).arg(us(s.p95), 8).arg(us(s.p99), 8).arg(us(s.max), 8);
+    }
+    lines << QString("window: %1 ticks").arg(window_filled);
+
+    int textWidth = 0;
+    for (const QString& line : lines) {
+        textWidth = qMax(textWidth, metrics.horizontalAdvance(line));
+    }
+    const QRect box(area.right() - textWidth - padding * 3, area.top() + padding,
+                    textWidth + padding * 2, lineHeight * lines.size() + padding * 2);
+
+    painter.save();
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 170));
+    painter.drawRect(box);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    int y = box.top() + padding + metrics.ascent();
+    for (const QString& line : lines) {
+        painter.drawText(box.left() + padding, y, line);
+        y += lineHeight;
+    }
+    painter.restore();
+}
+
+const char* FrameProfiler::stageName(Stage stage)
+{
+    if (stage < StageAfterimages) {
+        return SimulationWorld::stageName(static_cast<SimulationWorld::Stage>(stage));
+    }
+    switch (stage) {
+    case StageAfterimages: return "afterimages";
+    case StageUi:          return "ui";
+    case StagePaint:       return "paint";
+    default:               return "unknown";
+    }
+}
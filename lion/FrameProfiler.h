@@ -0,0 +1,170 @@
+/**
+ * @file FrameProfiler.h
+ * @brief 逐tick分阶段耗时统计：滚动分位数、游戏内叠加层与CSV导出
+ * @author 开发团队
+ * @date 2025-11-28
+ * @version 1.0.0
+ */
+
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include "SimulationWorld.h"
+#include <QElapsedTimer>
+#include <QRect>
+#include <QFile>
+#include <QTextStream>
+#include <QVector>
+#include <QString>
+
+class QPainter;
+
+/**
+ * @class FrameProfiler
+ * @brief 帧耗时分析器（单例）
+ *
+ * 前几个阶段与 SimulationWorld::Stage 一一对应，由模拟世界的分阶段计时
+ * 提供；残影、界面标签与绘制在 GameScene 中用 Scope 计时。每个tick结束时
+ * 调用 commitTick() 把本tick各阶段耗时写入滚动窗口（最近 WINDOW_TICKS 个
+ * tick），并在打开CSV时追加一行。绘制按帧发生，两次tick之间的绘制耗时
+ * 计入下一个tick。
+ *
+ * 叠加层与CSV都关闭时 isEnabled() 为false，各计时点不读取时钟。
+ * 只能在GUI线程使用。
+ */
+class FrameProfiler
+{
+public:
+    /**
+     * @enum Stage
+     * @brief 计时阶段（模拟阶段在前，顺序与 SimulationWorld::Stage 一致）
+     */
+    enum Stage {
+        StagePlatforms = 0,     ///< 移动平台
+        StagePlayer,            ///< 玩家运动
+        StagePlatformCollision, ///< 移动平台碰撞与跟随
+        StageDoors,             ///< 门阻挡
+        StageTraps,             ///< 箭机关发射
+        StageProjectiles,       ///< 箭矢运动与命中
+        StageSwitches,          ///< 开关
+        StageElements,          ///< 收集、水、岩浆与出口
+        StageAfterimages,       ///< 残影更新
+        StageUi,                ///< 目标与提示标签更新
+        StagePaint,             ///< 场景绘制
+        StageCount
+    };
+
+    static constexpr int WINDOW_TICKS = 600;        ///< 滚动窗口长度（tick）
+    static constexpr int OVERLAY_REFRESH_MS = 250;  ///< 叠加层统计刷新间隔
+
+    /**
+     * @struct StageStats
+     * @brief 某阶段在滚动窗口内的耗时分布（纳秒）
+     */
+    struct StageStats {
+        qint64 p50 = 0;
+        qint64 p95 = 0;
+        qint64 p99 = 0;
+        qint64 max = 0;
+    };
+
+    /**
+     * @class Scope
+     * @brief 作用域计时器：析构（或调用 stop()）时把耗时计入阶段
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(Stage stage);
+        ~Scope() { stop(); }
+        void stop();
+
+    private:
+        Stage stage;
+        QElapsedTimer timer;
+        bool running;
+    };
+
+    /**
+     * @brief 获取单例实例
+     * @return FrameProfiler& 单例引用
+     */
+    static FrameProfiler& getInstance();
+
+    /**
+     * @brief 是否需要计时（叠加层可见或正在导出CSV）
+     */
+    bool isEnabled() const { return overlay_visible || csv_file.isOpen(); }
+
+    bool isOverlayVisible() const { return overlay_visible; }
+    void toggleOverlay() { overlay_visible = !overlay_visible; }
+
+    /**
+     * @brief 打开CSV输出文件，之后每个tick写入一行（单位纳秒）
+     * @param path 文件路径
+     * @return bool 是否打开成功
+     */
+    bool openCsv(const QString& path);
+
+    /**
+     * @brief 写完缓冲并关闭CSV文件
+     */
+    void closeCsv();
+
+    /**
+     * @brief 累加本tick某阶段的耗时
+     * @param stage 阶段
+     * @param ns 耗时（纳秒）
+     */
+    void addSample(Stage stage, qint64 ns) { tick_ns[stage] += ns; }
+
+    /**
+     * @brief 从模拟世界读取本tick各模拟阶段的耗时（读取后清零）
+     * @param world 模拟世界
+     */
+    void collectWorldStages(SimulationWorld& world);
+
+    /**
+     * @brief 结束一个tick：写入滚动窗口与CSV，清空本tick耗时
+     * @param tick tick序号
+     */
+    void commitTick(quint32 tick);
+
+    /**
+     * @brief 计算某阶段在滚动窗口内的分位数
+     * @param stage 阶段
+     * @return StageStats 耗时分布
+     */
+    StageStats computeStats(Stage stage) const;
+
+    /**
+     * @brief 在画面右上角绘制统计叠加层
+     * @param painter 画笔（未做摄像机变换）
+     * @param area 可绘制区域
+     */
+    void drawOverlay(QPainter& painter, const QRect& area);
+
+    /**
+     * @brief 获取阶段名称（CSV列名与叠加层行名）
+     */
+    static const char* stageName(Stage stage);
+
+private:
+    FrameProfiler();
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+    bool overlay_visible;                           ///< 叠加层是否可见
+    qint64 tick_ns[StageCount];                     ///< 本tick各阶段耗时
+    QVector<qint64> window[StageCount];             ///< 各阶段滚动窗口（环形）
+    int window_pos;                                 ///< 下一个写入位置
+    int window_filled;                              ///< 窗口中的有效样本数
+
+    StageStats overlay_stats[StageCount];           ///< 叠加层显示的统计（定期刷新）
+    QElapsedTimer overlay_refresh;                  ///< 叠加层统计刷新计时
+
+    QFile csv_file;                                 ///< CSV输出文件
+    QTextStream csv_stream;                         ///< CSV写入流
+};
+
+#endif // FRAMEPROFILER_H
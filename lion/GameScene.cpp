@@ -7,6 +7,11 @@
 
 #include "GameScene.h"
 #include "LionAnimation.h"
+#include "AudioController.h"
+#include "TextureCache.h"
+#include "ProgressStore.h"
+#include "FrameProfiler.h"
+#include "LogCategories.h"
 #include <QPushButton>
 #include "qpainter.h"
 #include "QKeyEvent"
@@ -14,7 +19,6 @@
 #include <QVBoxLayout>
 #include <QLabel>
 #include <QKeyEvent>
-#include <QDebug>
 #include "Config.h"
 #include <QPropertyAnimation>
 #include <QGraphicsOpacityEffect>
@@ -26,17 +30,23 @@
 #include <QDir>
 #include <QApplication>
 #include <QDateTime>
-extern int map[GRID_WIDTH][GRID_HEIGHT];
-int map[GRID_WIDTH][GRID_HEIGHT];
-int map1[GRID_WIDTH][GRID_HEIGHT];
+#include <QtMath>
 GameScene::GameScene(QWidget* parent): QWidget(parent){
 
     // 设置场景基本属性
     setWindowTitle(TITLE);
     setFixedSize(XSIZE, YSIZE);  // 匹配项目分辨率
-    memset(map,0,sizeof(map));
     background=BackGround(1);
     
+    // 视口固定为一屏，静态图层分块缓存限制在固定块数内
+    camera.setViewportSize(QSizeF(XSIZE, YSIZE));
+    static_chunks.setMaxCost(STATIC_CHUNK_CACHE);
+    
+    // 玩家动画控件只负责提供帧，不参与布局显示
+    lion_animation = new LionAnimation(this);
+    lion_animation->hide();
+    world.getPlayer().setAnimation(lion_animation);
+    
     // === 新增：初始化关卡系统 ===
     current_level_data = nullptr;
     
@@ -47,15 +57,17 @@ GameScene::GameScene(QWidget* parent): QWidget(parent){
     restart_button = nullptr;
     main_menu_button = nullptr;
     
-    // 初始化UI标签
-    objective_label = new QLabel(this);
-    objective_label->setGeometry(10, 10, 300, 30);
-    objective_label->setStyleSheet("color: white; font-size: 16px; font-weight: bold; background-color: rgba(0,0,0,100);");
-    
-    tutorial_label = new QLabel(this);
-    tutorial_label->setGeometry(10, 50, 400, 60);
-    tutorial_label->setStyleSheet("color: yellow; font-size: 14px; background-color: rgba(0,0,0,100);");
-    tutorial_label->setWordWrap(true);
+    // 初始化界面文字：在 paintEvent 中直接绘制，不再使用逐tick更新的标签控件
+    hud_objective_font.setPixelSize(16);
+    hud_objective_font.setBold(true);
+    hud_hint_font.setPixelSize(14);
+    hud_message_font.setPixelSize(18);
+    hud_message_font.setBold(true);
+    hud_objective_text.setTextFormat(Qt::PlainText);
+    hud_hint_text.setTextFormat(Qt::PlainText);
+    hud_hint_text.setTextWidth(HUD_HINT_WIDTH);
+    hud_message_text.setTextFormat(Qt::PlainText);
+    hud_message_text.setTextWidth(HUD_HINT_WIDTH - 2 * HUD_MESSAGE_PADDING);
     
     // 初始化返回按钮
     back_button = new QPushButton("返回", this);
@@ -83,70 +95,83 @@ GameScene::GameScene(QWidget* parent): QWidget(parent){
         emit backToMainMenu();
     });
     
-    // 加载纹理资源（使用Qt资源路径，避免工作目录影响）
-    vegetable_texture.load(":/images/vegetable.png");
+    // 加载纹理资源（使用Qt资源路径，避免工作目录影响；经纹理缓存共享，启动时已预解码）
+    TextureCache& textures = TextureCache::getInstance();
+    vegetable_texture = textures.pixmap(":/images/vegetable.png");
     if (vegetable_texture.isNull()) {
         // 如果没有青菜图片，创建一个简单的绿色方块
         vegetable_texture = QPixmap(B0, B0);
         vegetable_texture.fill(Qt::green);
     }
     
-    exit_texture.load(":/images/door.png");
+    exit_texture = textures.pixmap(":/images/door.png");
     if (exit_texture.isNull()) {
         // 如果没有出口图片，创建一个简单的红色方块
         exit_texture = QPixmap(B0, B0);
         exit_texture.fill(Qt::red);
     }
     
-    // 加载箭机关纹理（统一使用 archery.png）
-    arrow_trap_right_texture.load(":/images/archery.png");
-    arrow_trap_left_texture.load(":/images/archery.png");
-    arrow_trap_up_texture.load(":/images/archery.png");
-    arrow_trap_down_texture.load(":/images/archery.png");
-    // 修正箭机关默认朝向：顺时针旋转90°
+    // 加载箭机关纹理（统一使用 archery.png），按方向建表
     {
-        QTransform archeryRotate;
-        archeryRotate.rotate(90);
-        if (!arrow_trap_right_texture.isNull())
-            arrow_trap_right_texture = arrow_trap_right_texture.transformed(archeryRotate, Qt::SmoothTransformation);
-        if (!arrow_trap_left_texture.isNull())
-            arrow_trap_left_texture = arrow_trap_left_texture.transformed(archeryRotate, Qt::SmoothTransformation);
-        if (!arrow_trap_up_texture.isNull())
-            arrow_trap_up_texture = arrow_trap_up_texture.transformed(archeryRotate, Qt::SmoothTransformation);
-        if (!arrow_trap_down_texture.isNull())
-            arrow_trap_down_texture = arrow_trap_down_texture.transformed(archeryRotate, Qt::SmoothTransformation);
+        QPixmap archery = textures.pixmap(":/images/archery.png");
+        if (!archery.isNull()) {
+            // 修正箭机关默认朝向：顺时针旋转90°
+            QTransform archeryRotate;
+            archeryRotate.rotate(90);
+            archery = archery.transformed(archeryRotate, Qt::SmoothTransformation);
+        }
+        for (QPixmap& sprite : arrow_trap_sprites) {
+            sprite = archery;
+        }
     }
     
     // 加载移动平台和开关门纹理（如果没有图片，创建简单的颜色方块）
-    horizontal_platform_texture.load(":/images/moving_platform.png");
+    horizontal_platform_texture = textures.pixmap(":/images/moving_platform.png");
     if (horizontal_platform_texture.isNull()) {
         horizontal_platform_texture = QPixmap(B0 * 2, B0);
         horizontal_platform_texture.fill(QColor(139, 69, 19)); // 棕色
     }
 
-    vertical_platform_texture.load(":/images/moving_platform.png");
+    vertical_platform_texture = textures.pixmap(":/images/moving_platform.png");
     if (vertical_platform_texture.isNull()) {
         vertical_platform_texture = QPixmap(B0, B0 * 2);
         vertical_platform_texture.fill(QColor(139, 69, 19)); // 棕色
     }
     
-    switch_texture.load(":/images/switch.svg");
+    switch_texture = textures.pixmap(":/images/switch.svg");
     if (switch_texture.isNull()) {
         switch_texture = QPixmap(B0, B0);
         switch_texture.fill(QColor(255, 255, 0)); // 黄色
     }
     
-    door_texture.load(":/images/door.png");
+    door_texture = textures.pixmap(":/images/door.png");
     if (door_texture.isNull()) {
         door_texture = QPixmap(B0, B0);
         door_texture.fill(QColor(101, 67, 33)); // 深棕色
     }
 
-    // 加载箭矢纹理（保持原始方向）
-    arrow_texture.load(":/images/arrow.png");
-    if (arrow_texture.isNull()) {
-        arrow_texture = QPixmap(B0, B0 / 4);
-        arrow_texture.fill(Qt::red);
+    // 加载箭矢纹理（原图朝右），预先生成四个方向的贴图
+    QPixmap arrow = textures.pixmap(":/images/arrow.png");
+    if (arrow.isNull()) {
+        arrow = QPixmap(B0, B0 / 4);
+        arrow.fill(Qt::red);
+    }
+    {
+        QTransform up;
+        up.rotate(-90);
+        QTransform down;
+        down.rotate(90);
+        arrow_sprites[int(ArrowDirection::Right)] = arrow;
+        arrow_sprites[int(ArrowDirection::Left)] = QPixmap::fromImage(arrow.toImage().mirrored(true, false));
+        arrow_sprites[int(ArrowDirection::Up)] = arrow.transformed(up, Qt::SmoothTransformation);
+        arrow_sprites[int(ArrowDirection::Down)] = arrow.transformed(down, Qt::SmoothTransformation);
+    }
+    
+    // 方块纹理只解码一次，静态图层重建时复用
+    block5 = textures.pixmap(BLOCK5);
+    if (block5.isNull()) {
+        block5 = QPixmap(B0, B0);
+        block5.fill(Qt::gray);
     }
     
     init();
@@ -173,40 +198,7 @@ void GameScene::init()
     setFixedSize(XSIZE, YSIZE);
     setWindowTitle(TITLE);
     Timer.setInterval(GAME_TICK);
-    mapInit();
-}
-void GameScene::mapInit(){
-    for(int i=0;i<GRID_WIDTH;i++)
-        for(int j=23;j>20;j--)
-            map[i][j]=1;
-    for(int i=0;i<17;i++)
-        map[i][19]=1;
-    for(int i=23;i>17;i--)
-        map[i][18]=1;
-    for(int i=7;i<22;i++)
-        map[i][16]=1;
-    for(int i=0;i<14;i++)
-        map[i][13]=1;
-    for(int i=4;i<9;i++)
-        map[i][5]=1;
-    for(int i=0;i<3;i++)
-        map[i][2]=1;
-        map[4][18]=map[20][15]=map[13][14]=map[16][14]=
-        map[17][14]=map[18][14]=map[21][14]=map[22][13]=
-        map[22][12]=map[20][12]=map[19][12]=map[18][12]=
-        map[2][11]=map[3][11]=map[22][11]=map[13][10]=
-        map[16][10]=map[17][10]=map[21][10]=map[0][9]=
-        map[1][9]=map[6][9]=map[7][9]=map[5][9]=
-        map[12][9]=map[19][9]=map[20][9]=map[21][9]=
-        map[11][8]=map[15][8]=map[16][8]=map[2][7]=
-        map[3][7]=map[10][7]=map[9][6]=map[17][6]=
-        map[18][6]=map[19][6]=map[23][6]=map[15][5]=
-        map[14][5]=map[20][5]=map[22][5]=map[12][4]=
-        map[13][4]=map[22][4]=map[4][3]=map[5][3]=
-        map[11][3]=map[10][2]=map[9][1]=map[9][0]=1;
-    for(int i=0;i<GRID_WIDTH;i++)
-        for(int j=0;j<GRID_HEIGHT;j++)
-            map1[i][j]=map[i][j];
+    Timer.setTimerType(Qt::PreciseTimer);
 }
 void GameScene::gameStart()
 {
@@ -215,164 +207,132 @@ void GameScene::gameStart()
     Timer.start();
     level_timer.restart();
     
-    // 初始化移动平台和开关门
-    initializeMovingPlatforms();
-    initializeSwitchDoors();
-    
-    // pl.setMoveState(leftpress,rightpress);
+    // 固定步长调度：累加真实流逝时间，每满一个 GAME_TICK 推进一次模拟
+    frame_clock.start();
+    tick_accumulator_ns = 0;
+    render_alpha = 0.0;
     connect(&Timer,&QTimer::timeout,[=](){
-        // 如果游戏暂停，不更新游戏逻辑
+        const qint64 elapsedNs = frame_clock.nsecsElapsed();
+        frame_clock.restart();
+        
+        // 如果游戏暂停，不更新游戏逻辑，并丢弃暂停期间的时间，恢复后不追帧
         if (is_paused) {
+            tick_accumulator_ns = 0;
             return;
         }
         
-        tick_counter++;
-        
-        // === 新增：更新移动平台 ===
-        updateMovingPlatforms();
-        
-        // 保存玩家移动前的位置
-        int prev_x = pl.x;
-        int prev_y = pl.y;
-        
-        pl.update();
-
-        // +++ 新增：更新残影逻辑
-        updateAfterimages();
-
-        // 只有当玩家不在移动平台上，或者在移动平台上但有主动输入时，才处理左右移动和动画
-        if (!pl.onMovingPlatform || (pl.onMovingPlatform && (leftpress || rightpress))) {
-            if(leftpress) pl.left();
-            if(rightpress) pl.right();
-        }
-
-        // 动画状态由player.updateAnimationState()统一处理，此处不再重复处理
-        
-        // === 新增：检查移动平台碰撞（在玩家更新后） ===
-        checkMovingPlatformCollisions();
-        
-        // === 新增：处理玩家跟随移动平台（在碰撞检测后，独立处理） ===
-        handlePlatformFollowing();
-        
-        // 检查门碰撞，如果与关闭的门碰撞则恢复到之前的位置
-        QRectF playerRect(pl.x, pl.y, pl.w, pl.h);
-        if (checkDoorCollision(playerRect)) {
-            pl.x = prev_x;
-            pl.y = prev_y;
-        }
-        
-        // 箭机关：周期性发射箭矢
-        if (current_level_data && tick_counter % 60 == 0) { // 每1秒发射一次
-            const auto& elements = current_level_data->getGameElements();
-            for (const auto& e : elements) {
-                if (e.element_type == GameElementType::ArrowTrap) {
-                    Projectile p;
-                    p.pos = e.position + QPointF(e.size.x()/2, e.size.y()/2);
-                    p.size = QPointF(20.0, 6.0);
-                    p.active = true;
-                    
-                    // 根据方向设置速度和大小
-                    QString direction = "right"; // 默认方向
-                    if (e.properties.contains("direction")) {
-                        direction = e.properties.value("direction").toString();
-                    }
-                    
-                    float speed = 6.0f; // 约3格/秒的速度
-                    if (direction == "right") {
-                        p.vel = QPointF(speed, 0.0);
-                        p.size = QPointF(2 * B0, 8.0); // 调整箭大小：长度2格，厚度8像素
-                    } else if (direction == "left") {
-                        p.vel = QPointF(-speed, 0.0);
-                        p.size = QPointF(2 * B0, 8.0);
-                    } else if (direction == "up") {
-                        p.vel = QPointF(0.0, -speed);
-                        p.size = QPointF(8.0, 2 * B0);
-                    } else if (direction == "down") {
-                        p.vel = QPointF(0.0, speed);
-                        p.size = QPointF(8.0, 2 * B0);
-                    }
-                    
-                    projectiles.push_back(p);
-                }
+        const qint64 tickNs = GAME_TICK * 1000000LL;
+        tick_accumulator_ns += elapsedNs;
+        int steps = 0;
+        while (tick_accumulator_ns >= tickNs) {
+            if (steps >= MAX_CATCHUP_TICKS) {
+                // 事件循环长时间阻塞：超出追帧上限的积压直接丢弃，避免越追越慢
+                tick_accumulator_ns %= tickNs;
+                break;
             }
-        }
-        // 更新箭矢位置并检测碰撞/出界
-        if (!projectiles.isEmpty()) {
-            QRectF playerRect(pl.x, pl.y, pl.w, pl.h);
-            for (auto &p : projectiles) {
-                if (!p.active) continue;
-                p.pos += p.vel;
-                
-                // 检查出界
-                if (p.pos.x() < -50 || p.pos.x() > XSIZE + 50 || p.pos.y() < -50 || p.pos.y() > YSIZE + 50) {
-                    p.active = false;
-                    continue;
-                }
-                
-                QRectF arrowRect(p.pos.x(), p.pos.y(), p.size.x(), p.size.y());
-                
-                // 检查与玩家的碰撞
-                if (arrowRect.intersects(playerRect)) {
-                    is_dead = true;
-                    Timer.stop();
-                    gameover();
-                    return;
-                }
-                
-                // 检查与方块的碰撞
-                bool hitBlock = false;
-                
-                // 检查箭矢四个角是否与实心方块碰撞
-                int leftCol = static_cast<int>(p.pos.x()) / B0;
-                int rightCol = static_cast<int>(p.pos.x() + p.size.x()) / B0;
-                int topRow = static_cast<int>(p.pos.y()) / B0;
-                int bottomRow = static_cast<int>(p.pos.y() + p.size.y()) / B0;
-                
-                // 确保坐标在地图范围内
-                leftCol = qMax(0, qMin(leftCol, GRID_WIDTH - 1));
-                rightCol = qMax(0, qMin(rightCol, GRID_WIDTH - 1));
-                topRow = qMax(0, qMin(topRow, GRID_HEIGHT - 1));
-                bottomRow = qMax(0, qMin(bottomRow, GRID_HEIGHT - 1));
-                
-                // 检查箭矢覆盖的所有网格
-                for (int col = leftCol; col <= rightCol && !hitBlock; ++col) {
-                    for (int row = topRow; row <= bottomRow && !hitBlock; ++row) {
-                        if (map[col][row] == 1) { // 实心方块
-                            hitBlock = true;
-                        }
-                    }
-                }
-                
-                // 如果与方块碰撞，标记箭矢为无效
-                if (hitBlock) {
-                    p.active = false;
-                }
+            tick_accumulator_ns -= tickNs;
+            ++steps;
+            if (!simulateTick()) {
+                return; // 本tick已胜利或死亡，定时器已停止
             }
-            // 清理无效箭矢
-            projectiles.erase(std::remove_if(projectiles.begin(), projectiles.end(), [](const Projectile& pr){return !pr.active;}), projectiles.end());
         }
         
-        // === 新增：检查开关碰撞 ===
-        checkSwitchCollisions();
-        
-        // === 新增：检查游戏元素碰撞 ===
-        checkGameElementCollisions();
-        
-        // === 新增：更新UI显示 ===
-        updateObjectiveDisplay();
-        updateTutorialHints();
-        
-        // 设置游戏开始状态
-        if(pl.getLeftPressed() || pl.getRightPressed()){
-            if(begin==false)
-                begin=true;
-        }
+        // 剩余不足一个tick的时间用于在上一状态与当前状态之间插值渲染
+        render_alpha = static_cast<double>(tick_accumulator_ns) / tickNs;
         update();
-
     });
 }
+
+bool GameScene::simulateTick()
+{
+    // 按键事件只记录状态，统一在tick边界交给模拟世界
+    InputFrame input;
+    if (is_replaying) {
+        input = replay_playback.frameAt(world.getTickCount());
+    } else {
+        input.left = leftpress;
+        input.right = rightpress;
+        input.jump = jump_requested;
+        input.dash = dash_requested;
+        replay_recorder.record(input);
+    }
+    jump_requested = false;
+    dash_requested = false;
+    
+    FrameProfiler& profiler = FrameProfiler::getInstance();
+    world.setStageTimingEnabled(profiler.isEnabled());
+    const StepResult result = world.step(input);
+    profiler.collectWorldStages(world);
+    
+    // +++ 新增：更新残影逻辑
+    {
+        FrameProfiler::Scope scope(FrameProfiler::StageAfterimages);
+        updateAfterimages();
+    }
+    
+    if (result.jumped) {
+        AudioController::getInstance().playSound(SoundType::Jump);
+    }
+    
+    const ElementStore& store = world.getElementStore();
+    for (int index : result.collected_elements) {
+        const CollectibleComponent* collectible = store.collectibles.find(index);
+        if (!collectible) continue;
+        if (collectible->kind == CollectibleKind::Exit) {
+            AudioController::getInstance().playSound(SoundType::Win);
+            // 已到达的出口不再绘制，静态图层需要重建
+            invalidateStaticLayer();
+        } else {
+            AudioController::getInstance().playSound(SoundType::Collect);
+        }
+    }
+    
+    if (result.player_died) {
+        is_dead = true;
+        Timer.stop();
+        finishReplay();
+        gameover();
+        return false;
+    }
+    if (result.level_completed) {
+        Timer.stop();
+        finishReplay();
+        gamewin();
+        return false;
+    }
+    if (result.exit_blocked) {
+        // 未满足通关条件，显示提示
+        LJ_HOT_DEBUG(lcObjective) << "还有目标未完成，无法通关！";
+        showGameMessage("还有目标未完成，无法通关！", 3000);
+    }
+    
+    // 设置游戏开始状态
+    const bool justBegan = !begin && (input.left || input.right);
+    if (justBegan) {
+        begin = true;
+    }
+    
+    // 界面文字只在目标进度或游戏状态变化时重建
+    if (result.objectives_changed || justBegan) {
+        FrameProfiler::Scope scope(FrameProfiler::StageUi);
+        updateObjectiveDisplay();
+        updateTutorialHints();
+    }
+    profiler.commitTick(world.getTickCount());
+    
+    return true;
+}
+
 void GameScene::keyPressEvent(QKeyEvent *event) //按键事件
 {
+    // F3显示/隐藏帧耗时统计（暂停时也可切换）
+    if (event->key() == Qt::Key_F3 && !event->isAutoRepeat())
+    {
+        FrameProfiler::getInstance().toggleOverlay();
+        update();
+        return;
+    }
+    
     // ESC键暂停/恢复游戏
     if (event->key() == Qt::Key_Escape)
     {
@@ -387,32 +347,29 @@ void GameScene::keyPressEvent(QKeyEvent *event) //按键事件
         return;
     }
     
-    // 如果游戏暂停，不处理其他按键
-    if (is_paused)
+    // 如果游戏暂停或正在回放，不处理其他按键
+    if (is_paused || is_replaying)
     {
         return;
     }
     
     if (event->key() == Qt::Key_A && event->type())
     {
-        // leftpress = 1;
-        // pl.setMoveState(leftpress, rightpress);
-        pl.setLeftPressed(true);
+        leftpress = true;
     }
     else if (event->key() == Qt::Key_D)
     {
-        // rightpress = 1;
-        // pl.setMoveState(leftpress, rightpress);
-        pl.setRightPressed(true);
+        rightpress = true;
     }
-    else if (event->key() == Qt::Key_K && !pl.isJump && (pl.onGround || pl.onMovingPlatform))
+    else if (event->key() == Qt::Key_K)
     {
-        pl.jump();
+        // 是否允许起跳由模拟世界在下一tick判断
+        jump_requested = true;
     }
     // +++ 新增：Shift键触发冲刺
     else if (event->key() == Qt::Key_Shift && !event->isAutoRepeat())
     {
-        pl.startDash();
+        dash_requested = true;
     }
     update();
 }
@@ -426,13 +383,11 @@ void GameScene::keyReleaseEvent(QKeyEvent *event)//松开按键事件
     
     if (event->key() == Qt::Key_A && event->type())
     {
-        // leftpress = 0;
-        pl.setLeftPressed(false);
+        leftpress = false;
     }
     if (event->key() == Qt::Key_D)
     {
-        // rightpress = 0;
-        pl.setRightPressed(false);
+        rightpress = false;
     }
     update();
 }
@@ -449,53 +404,68 @@ void GameScene::resizeEvent(QResizeEvent *event)
 
 void GameScene::paintEvent(QPaintEvent *event)
 {
+    FrameProfiler::Scope paintScope(FrameProfiler::StagePaint);
     QPainter painter(this);
-    block5.load(BLOCK5);
-    if (block5.isNull()) {
-        block5 = QPixmap(B0, B0);
-        block5.fill(Qt::gray);
-    }
     painter.drawPixmap(background.map1_x, 0,XSIZE+5,YSIZE, background.map1);
     painter.drawPixmap(background.map2_x, 0,XSIZE+5,YSIZE, background.map2);
     painter.drawPixmap(background.map3_x, 0,XSIZE+5,YSIZE, background.map3);
     
-    for(int i=0;i<GRID_WIDTH;i++)
-        for(int j=0;j<GRID_HEIGHT;j++)
-        {
-            switch(map1[i][j]){
-            case 1:
-                painter.drawPixmap(i*B0, j*B0,W,W, block5);
-                break;
+    // 出口的可通关状态变化时，静态图层需要按新透明度重绘
+    if (static_layer_exit_unlocked != isExitUnlocked()) {
+        invalidateStaticLayer();
+    }
+    
+    // 摄像机跟随插值后的玩家位置，世界内容整体平移；背景与界面控件不受影响
+    player& pl = world.getPlayer();
+    const QPointF playerPos = interpolatedPlayerPos();
+    camera.centerOn(playerPos + QPointF(pl.w / 2.0, pl.h / 2.0));
+    const QRectF view = camera.getViewRect();
+    painter.save();
+    painter.translate(-camera.getPosition());
+    
+    // 实心方块与静态元素按分块贴图，只取与视口相交的分块
+    if (current_level_data) {
+        const int chunkPx = CHUNK_TILES * B0;
+        const int firstX = qMax(0, static_cast<int>(view.left()) / chunkPx);
+        const int firstY = qMax(0, static_cast<int>(view.top()) / chunkPx);
+        const int lastX = qMin(current_level_data->getChunkColumns() - 1, static_cast<int>(view.right()) / chunkPx);
+        const int lastY = qMin(current_level_data->getChunkRows() - 1, static_cast<int>(view.bottom()) / chunkPx);
+        for (int cy = firstY; cy <= lastY; ++cy) {
+            for (int cx = firstX; cx <= lastX; ++cx) {
+                const QPixmap* chunk = staticChunk(cx, cy);
+                if (chunk && !chunk->isNull()) {
+                    painter.drawPixmap(cx * chunkPx, cy * chunkPx, *chunk);
+                }
             }
         }
+    }
     
-    // 绘制游戏元素
-    drawGameElements(painter);
-    
-    // 绘制箭矢（使用贴图并根据方向旋转/镜像）
-    for (const auto &p : projectiles) {
-        if (!p.active) continue;
-        QRectF arrowRect(p.pos.x(), p.pos.y(), p.size.x(), p.size.y());
-        QPixmap pix = arrow_texture;
-        // 根据速度方向旋转或镜像
-        if (std::abs(p.vel.y()) > std::abs(p.vel.x())) {
-            // 垂直方向
-            QTransform tf;
-            if (p.vel.y() < 0) {
-                tf.rotate(-90);
-            } else {
-                tf.rotate(90);
-            }
-            pix = pix.transformed(tf, Qt::SmoothTransformation);
+    // 绘制动态游戏元素
+    drawGameElements(painter, view);
+    
+    // 绘制箭矢（使用按方向预生成的贴图）
+    const ProjectilePool& projectiles = world.getProjectiles();
+    for (int i = 0; i < projectiles.highWater(); ++i) {
+        if (!projectiles.isActive(i)) continue;
+        // 箭矢匀速运动，插值位置即当前位置回退 (1 - alpha) 个速度
+        const QPointF vel(projectiles.velX(i), projectiles.velY(i));
+        const QPointF drawPos = QPointF(projectiles.posX(i), projectiles.posY(i)) + vel * (render_alpha - 1.0);
+        QRectF arrowRect(drawPos.x(), drawPos.y(), projectiles.sizeX(i), projectiles.sizeY(i));
+        if (!arrowRect.intersects(view)) continue;
+        // 按速度方向取预生成的贴图：竖直分量占优时朝上/下，否则朝左/右
+        ArrowDirection direction;
+        if (std::abs(vel.y()) > std::abs(vel.x())) {
+            direction = vel.y() < 0 ? ArrowDirection::Up : ArrowDirection::Down;
         } else {
-            // 水平方向：向左时镜像
-            if (p.vel.x() < 0) {
-                pix = QPixmap::fromImage(pix.toImage().mirrored(true, false));
-            }
+            direction = vel.x() < 0 ? ArrowDirection::Left : ArrowDirection::Right;
         }
-        painter.drawPixmap(arrowRect.toRect(), pix);
+        painter.drawPixmap(arrowRect.toRect(), arrow_sprites[int(direction)]);
     }
     
+    // 动画帧来自预缩放图集（角色尺寸或屏幕像素比变化时才重建）
+    lion_animation->buildAtlas(QSize(pl.w, pl.h), devicePixelRatioF());
+    const QPixmap& atlas = lion_animation->getAtlas();
+
     if (!afterimages.isEmpty()) {
         qint64 now = QDateTime::currentMSecsSinceEpoch();
         // 遍历所有残影
@@ -506,17 +476,26 @@ void GameScene::paintEvent(QPaintEvent *event)
 
             if (opacity > 0.1) { // 只绘制还未完全消失的
                 painter.setOpacity(opacity * 0.5); // 设置最大 50% 的透明度
-                painter.drawPixmap(img.rect.toRect(), img.frame);
+                painter.drawPixmap(img.rect.toRect(), atlas, img.frame);
             }
         }
         painter.setOpacity(1.0); // 恢复不透明度，准备绘制玩家
     }
 
-    // 绘制玩家角色
-    QPixmap currentFrame = pl.getCurrentAnimationFrame();
+    // 绘制玩家角色（在上一tick与当前tick之间插值）
+    const QRect currentFrame = pl.getCurrentAnimationFrame();
     if (!currentFrame.isNull()) {
-        painter.drawPixmap(pl.x, pl.y, pl.w, pl.h,
-                           currentFrame.scaled(pl.w, pl.h, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+        painter.drawPixmap(QRect(playerPos.toPoint(), QSize(pl.w, pl.h)), atlas, currentFrame);
+    }
+    painter.restore();
+    
+    // 界面文字绘制在世界内容之上（子控件仍会覆盖在其上）
+    drawHud(painter);
+    
+    // 帧耗时统计叠加层不计入绘制耗时
+    paintScope.stop();
+    if (FrameProfiler::getInstance().isOverlayVisible()) {
+        FrameProfiler::getInstance().drawOverlay(painter, rect());
     }
 }
 
@@ -531,15 +510,15 @@ BackGround::BackGround(int num)
 {
     if(num==1)
     {
-        map1.load(BACK_GROUND1); //设置背景
-        map2.load(BACK_GROUND1);
-        map3.load(BACK_GROUND1);
+        map1 = TextureCache::getInstance().pixmap(BACK_GROUND1); //设置背景（三块共享同一份像素）
+        map2 = map1;
+        map3 = map1;
     }
     if(num==2)
     {
-        map1.load(BACK_GROUND2); //设置背景
-        map2.load(BACK_GROUND2);
-        map3.load(BACK_GROUND2);
+        map1 = TextureCache::getInstance().pixmap(BACK_GROUND2); //设置背景（三块共享同一份像素）
+        map2 = map1;
+        map3 = map1;
     }
     map1_x = XSIZE;
     map2_x = 0;
@@ -568,15 +547,16 @@ bool GameScene::loadLevel(int levelIndex)
 
 bool GameScene::loadLevelInternal(int levelIndex)
 {
-    qDebug() << "加载关卡：" << levelIndex;
+    qCDebug(lcLevel) << "加载关卡：" << levelIndex;
     
     // 从关卡管理器获取关卡数据
     current_level_data = LevelManager::getInstance().getLevelData(levelIndex);
     if (!current_level_data) {
-        qDebug() << "无法加载关卡" << levelIndex;
+        qCDebug(lcLevel) << "无法加载关卡" << levelIndex;
         return false;
     }
-    current_level_data->setCustomLevel(false);
+    // 保留文件路径，录像需要据此定位关卡
+    current_level_data->setCustomLevel(false, current_level_data->getFilePath());
     
     // 设置当前关卡
     LevelManager::getInstance().setCurrentLevel(levelIndex);
@@ -584,37 +564,16 @@ bool GameScene::loadLevelInternal(int levelIndex)
     // 重置关卡状态
     resetLevel();
     
-    // 从关卡数据更新传统地图数组（兼容现有代码）
-    // 手动填充地图数组以适应新的网格大小
-    for (int x = 0; x < GRID_WIDTH; ++x) {
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            GameElementType type = current_level_data->getElementAt(x, y);
-            if (type == GameElementType::SolidBlock) {
-                map[x][y] = 1;
-                map1[x][y] = 1;
-            } else {
-                map[x][y] = 0;
-                map1[x][y] = 0;
-            }
-        }
-    }
+    // 模拟世界按关卡数据重建碰撞地图并放置玩家
+    world.loadLevel(current_level_data);
+    qCDebug(lcLevel) << "玩家起始位置：" << world.getPlayer().pos();
     
-    // 调试：检查地图数据
-    int blockCount = 0;
-    for (int i = 0; i < GRID_WIDTH; i++) {
-        for (int j = 0; j < GRID_HEIGHT; j++) {
-            if (map1[i][j] == 1) {
-                blockCount++;
-            }
-        }
-    }
-    qDebug() << "地图中方块数量：" << blockCount;
+    // 网格已变化，静态图层与摄像机取景范围随之更新
+    onLevelDataLoaded();
     
-    // 设置玩家起始位置
-    QPointF startPos = current_level_data->getPlayerStartPosition();
-    pl.x = static_cast<int>(startPos.x());
-    pl.y = static_cast<int>(startPos.y());
-    qDebug() << "玩家起始位置：" << pl.x << "," << pl.y;
+    // 更新UI显示
+    updateObjectiveDisplay();
+    updateTutorialHints();
     
     // 保存游戏进度
     saveGameProgress(levelIndex);
@@ -622,7 +581,7 @@ bool GameScene::loadLevelInternal(int levelIndex)
     // 启动游戏定时器
     gameStart();
     
-    qDebug() << "关卡加载完成：" << current_level_data->getLevelName();
+    qCDebug(lcLevel) << "关卡加载完成：" << current_level_data->getLevelName();
     return true;
 }
 
@@ -634,36 +593,22 @@ bool GameScene::loadLevelFromFile(const QString& filePath)
     // 从文件加载关卡数据
     LevelData* levelData = levelManager.loadLevelFromFile(filePath);
     if (!levelData) {
-        qDebug() << "从文件加载关卡失败：" << filePath;
+        qCDebug(lcLevel) << "从文件加载关卡失败：" << filePath;
         return false;
     }
     
     // 保存当前关卡数据
     current_level_data = levelData;
-    current_level_data->setCustomLevel(true);
+    current_level_data->setCustomLevel(true, filePath);
     
     // 重置关卡状态
     resetLevel();
     
-    // 从关卡数据更新传统地图数组
-    // 手动填充地图数组以适应新的网格大小
-    for (int x = 0; x < GRID_WIDTH; ++x) {
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
-            GameElementType type = current_level_data->getElementAt(x, y);
-            if (type == GameElementType::SolidBlock) {
-                map[x][y] = 1;
-                map1[x][y] = 1;
-            } else {
-                map[x][y] = 0;
-                map1[x][y] = 0;
-            }
-        }
-    }
+    // 模拟世界按关卡数据重建碰撞地图并放置玩家
+    world.loadLevel(current_level_data);
     
-    // 设置玩家位置
-    QPointF playerPos = current_level_data->getPlayerStartPosition();
-    pl.x = static_cast<int>(playerPos.x());
-    pl.y = static_cast<int>(playerPos.y());
+    // 网格已变化，静态图层与摄像机取景范围随之更新
+    onLevelDataLoaded();
     
     // 更新UI显示
     updateObjectiveDisplay();
@@ -672,136 +617,13 @@ bool GameScene::loadLevelFromFile(const QString& filePath)
     // 启动游戏定时器
     gameStart();
     
-    qDebug() << "从文件加载关卡成功：" << filePath;
+    qCDebug(lcLevel) << "从文件加载关卡成功：" << filePath;
     return true;
 }
 
-void GameScene::checkGameElementCollisions()
-{
-    if (!current_level_data) return;
-    
-    QRectF playerRect(pl.x, pl.y, pl.w, pl.h);
-    bool touchedWater = false;
-    
-    const auto& elements = current_level_data->getGameElements();
-    for (const auto& element : elements) {
-        QRectF elementRect(element.position.x(), element.position.y(), 
-                          element.size.x(), element.size.y());
-        
-        if (playerRect.intersects(elementRect)) {
-            bool alreadyCollected = false;
-            for (const auto& collected : collected_items) {
-                if (collected.position == element.position && 
-                    collected.element_type == element.element_type) {
-                    alreadyCollected = true;
-                    break;
-                }
-            }
-            
-            switch (element.element_type) {
-            case GameElementType::Vegetable:
-                if (!alreadyCollected) collectItem(element);
-                break;
-            case GameElementType::LevelExit: {
-                // 检查关卡完成条件
-                bool canComplete = false;
-                const auto& objectives = current_level_data->getObjectives();
-                
-                if (objectives.isEmpty()) {
-                    // 没有设置目标，直接允许通关（向后兼容）
-                    canComplete = true;
-                } else {
-                    // 有目标设置，检查是否有青菜收集目标
-                    bool hasVegetableObjective = false;
-                    bool allVegetablesCollected = true;
-                    
-                    for (const auto& obj : objectives) {
-                        if (obj.objective_type == "collect_vegetables") {
-                            hasVegetableObjective = true;
-                            if (!obj.isCompleted()) {
-                                allVegetablesCollected = false;
-                                break;
-                            }
-                        }
-                    }
-                    
-                    if (hasVegetableObjective) {
-                        // 有青菜收集目标，必须完成才能通关
-                        canComplete = allVegetablesCollected;
-                    } else {
-                        // 没有青菜收集目标，检查所有其他目标是否完成
-                        canComplete = current_level_data->areAllObjectivesCompleted();
-                    }
-                }
-                
-                if (canComplete) {
-                    // 可以通关
-                    if (!alreadyCollected) {
-                        collectItem(element);
-                        Timer.stop();
-                        gamewin();
-                        return;
-                    }
-                } else {
-                    // 未满足通关条件，显示提示
-                    qDebug() << "还有目标未完成，无法通关！";
-                    showGameMessage("还有目标未完成，无法通关！", 3000);
-                }
-                break;
-            }
-            case GameElementType::Water: {
-                touchedWater = true;
-                if (!is_in_water) {
-                    is_in_water = true;
-                    // 进入水域后：移动速度减半
-                    pl.setMoveSpeedScale(0.5);
-                }
-                break;
-            }
-            case GameElementType::Lava: {
-                is_dead = true;
-                Timer.stop();
-                gameover();
-                return;
-            }
-            default:
-                break;
-            }
-        }
-    }
-    // 离开水域时恢复
-    if (!touchedWater && is_in_water) {
-        is_in_water = false;
-        pl.setMoveSpeedScale(1.0);
-    }
-}
-
-
-void GameScene::collectItem(const GameElement& element)
-{
-    // 添加到已收集列表
-    collected_items.append(element);
-    
-    // 更新关卡目标进度
-    switch (element.element_type) {
-    case GameElementType::Vegetable:
-        AudioController::getInstance().playSound(SoundType::Collect);
-        current_level_data->updateObjectiveProgress("collect_vegetables", 1);
-        qDebug() << "收集到青菜！";
-        break;
-    case GameElementType::LevelExit:
-        AudioController::getInstance().playSound(SoundType::Win);
-        current_level_data->updateObjectiveProgress("reach_exit", 1);
-        qDebug() << "到达终点！";
-        break;
-    default:
-        break;
-    }
-}
-
 void GameScene::updateObjectiveDisplay()
 {
-    if (!current_level_data || !objective_label) return;
+    if (!current_level_data) return;
     
     QString objectiveText = "目标：";
     const auto& objectives = current_level_data->getObjectives();
@@ -813,17 +635,15 @@ void GameScene::updateObjectiveDisplay()
                         .arg(objective.target_count);
     }
     
-    objective_label->setText(objectiveText);
+    setHudText(hud_objective_text, objectiveText);
 }
 
 void GameScene::updateTutorialHints()
 {
-    if (!tutorial_label) return;
-    
     // 根据游戏状态显示不同的教学提示
     QString hintText;
     
-    if (!begin) {
+    if (!begin || !current_level_data) {
         hintText = "按 A/D 键移动，按 K 键跳跃\n收集所有青菜后到达红色终点！";
     } else {
         // 检查玩家进度给出提示
@@ -850,7 +670,49 @@ void GameScene::updateTutorialHints()
         }
     }
     
-    tutorial_label->setText(hintText);
+    setHudText(hud_hint_text, hintText);
+}
+
+void GameScene::drawHud(QPainter& painter)
+{
+    painter.save();
+    painter.setPen(Qt::NoPen);
+    
+    // 目标（背景随文字加宽，不截断）
+    const QSizeF objectiveSize = hud_objective_text.size();
+    const QRect objectiveBox(10, 10, qMax(300, qCeil(objectiveSize.width())), 30);
+    painter.fillRect(objectiveBox, QColor(0, 0, 0, 100));
+    painter.setFont(hud_objective_font);
+    painter.setPen(Qt::white);
+    painter.drawStaticText(QPointF(objectiveBox.left(), objectiveBox.top() + (objectiveBox.height() - objectiveSize.height()) / 2),
+                           hud_objective_text);
+    
+    // 临时消息显示期间替换教学提示
+    const QRect hintBox(10, 50, HUD_HINT_WIDTH, 60);
+    if (hud_message_duration > 0 && hud_message_timer.elapsed() < hud_message_duration) {
+        painter.setPen(QPen(QColor(255, 165, 0), 2));
+        painter.setBrush(QColor(255, 255, 0, 200));
+        painter.drawRoundedRect(QRectF(hintBox).adjusted(1, 1, -1, -1), 8, 8);
+        painter.setFont(hud_message_font);
+        painter.setPen(Qt::black);
+        painter.drawStaticText(hintBox.topLeft() + QPoint(HUD_MESSAGE_PADDING, HUD_MESSAGE_PADDING), hud_message_text);
+    } else if (!hud_hint_text.text().isEmpty()) {
+        hud_message_duration = 0;
+        painter.fillRect(hintBox, QColor(0, 0, 0, 100));
+        painter.setFont(hud_hint_font);
+        painter.setPen(Qt::yellow);
+        const QSizeF hintSize = hud_hint_text.size();
+        painter.drawStaticText(QPointF(hintBox.left(), hintBox.top() + (hintBox.height() - hintSize.height()) / 2),
+                               hud_hint_text);
+    }
+    painter.restore();
+}
+
+void GameScene::setHudText(QStaticText& text, const QString& value)
+{
+    if (text.text() != value) {
+        text.setText(value);
+    }
 }
 
 bool GameScene::checkLevelCompletion()
@@ -860,145 +722,211 @@ bool GameScene::checkLevelCompletion()
     return current_level_data->areAllObjectivesCompleted();
 }
 
-void GameScene::drawGameElements(QPainter& painter)
+void GameScene::drawGameElements(QPainter& painter, const QRectF& view)
 {
     if (!current_level_data) return;
     
     const auto& elements = current_level_data->getGameElements();
-    for (const auto& element : elements) {
-        bool isCollected = false;
-        for (const auto& collected : collected_items) {
-            if (collected.position == element.position && 
-                collected.element_type == element.element_type) {
-                isCollected = true;
-                break;
-            }
-        }
-        if (isCollected) continue;
+    
+    // 只取与可见区域重叠的元素，不再逐个扫描整个元素表
+    world.queryElements(view, visible_elements);
+    for (int i : visible_elements) {
+        const auto& element = elements[i];
+        // 静态元素已合成到静态图层中
+        if (isStaticLayerElement(element.element_type)) continue;
+        if (world.isCollected(i)) continue;
         
         QPixmap texture;
-        bool drawRect = false;
-        QColor rectColor;
         switch (element.element_type) {
         case GameElementType::Vegetable:
             texture = vegetable_texture;
             break;
-        case GameElementType::LevelExit:
-            texture = exit_texture;
-            break;
-        case GameElementType::Water:
-            drawRect = true;
-            rectColor = QColor(0, 120, 255, 180);
-            if (!water_texture.isNull()) texture = water_texture;
-            break;
-        case GameElementType::Lava:
-            drawRect = true;
-            rectColor = QColor(255, 60, 0, 200);
-            if (!lava_texture.isNull()) texture = lava_texture;
-            break;
-        case GameElementType::ArrowTrap:
-            {
-                // 根据箭机关方向选择对应纹理
-                QString direction = "right"; // 默认方向
-                if (element.properties.contains("direction")) {
-                    direction = element.properties["direction"].toString();
-                }
-                
-                if (direction == "right" && !arrow_trap_right_texture.isNull()) {
-                    texture = arrow_trap_right_texture;
-                } else if (direction == "left" && !arrow_trap_left_texture.isNull()) {
-                    texture = arrow_trap_left_texture;
-                } else if (direction == "up" && !arrow_trap_up_texture.isNull()) {
-                    texture = arrow_trap_up_texture;
-                } else if (direction == "down" && !arrow_trap_down_texture.isNull()) {
-                    texture = arrow_trap_down_texture;
-                } else {
-                    // 如果没有对应方向的纹理，使用默认颜色
-                    drawRect = true;
-                    rectColor = QColor(180, 180, 180, 200);
-                }
-            }
-            break;
-        case GameElementType::HorizontalPlatform:
-            texture = horizontal_platform_texture;
-            break;
-        case GameElementType::VerticalPlatform:
-            texture = vertical_platform_texture;
-            break;
         case GameElementType::Switch:
             texture = switch_texture;
             break;
         case GameElementType::Door:
+            // 门关闭时才显示
+            if (!world.isDoorClosed(i)) continue;
             texture = door_texture;
             break;
         default:
             continue;
         }
         
-        int x = static_cast<int>(element.position.x());
-        int y = static_cast<int>(element.position.y());
-        const int w = static_cast<int>(element.size.x());
-        const int h = static_cast<int>(element.size.y());
-        
-        // 对于移动平台，使用动态位置
-        if (element.element_type == GameElementType::HorizontalPlatform || 
-            element.element_type == GameElementType::VerticalPlatform) {
-            for (const auto& platform : moving_platforms) {
-                if (platform.element_index == &element - &elements[0]) {
-                    x = static_cast<int>(platform.current_pos.x());
-                    y = static_cast<int>(platform.current_pos.y());
-                    break;
-                }
-            }
+        if (!texture.isNull()) {
+            painter.drawPixmap(static_cast<int>(element.position.x()), static_cast<int>(element.position.y()),
+                               static_cast<int>(element.size.x()), static_cast<int>(element.size.y()), texture);
         }
+    }
+    
+    // 移动平台直接取模拟状态中的位置，在上一tick与当前tick之间插值
+    // 可见区域总在模拟的活动区域之内，只需检查活动平台
+    // 平台状态与移动组件同序
+    const auto& platforms = world.getMovingPlatforms();
+    const ElementStore& store = world.getElementStore();
+    for (int index : world.getActivePlatforms()) {
+        const auto& platform = platforms[index];
+        const QPixmap& texture = store.movers.at(index).horizontal
+                                     ? horizontal_platform_texture : vertical_platform_texture;
+        if (texture.isNull()) continue;
         
-        // 对于门，检查是否应该显示（门关闭时显示）
-        bool shouldDraw = true;
-        if (element.element_type == GameElementType::Door) {
-            for (const auto& switchDoor : switch_doors) {
-                if (switchDoor.door_element_index == &element - &elements[0]) {
-                    shouldDraw = !switchDoor.door_is_open;
-                    break;
-                }
-            }
+        const QSizeF size = store.rectOf(platform.element_index).size();
+        const QPointF drawPos = platform.prevPos() + (platform.currentPos() - platform.prevPos()) * render_alpha;
+        if (!view.intersects(QRectF(drawPos, size))) continue;
+        painter.drawPixmap(qRound(drawPos.x()), qRound(drawPos.y()),
+                           static_cast<int>(size.width()), static_cast<int>(size.height()), texture);
+    }
+}
+
+bool GameScene::isStaticLayerElement(GameElementType type)
+{
+    switch (type) {
+    case GameElementType::Water:
+    case GameElementType::Lava:
+    case GameElementType::LevelExit:
+    case GameElementType::ArrowTrap:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool GameScene::isExitUnlocked() const
+{
+    if (!current_level_data) return false;
+    
+    const auto& objectives = current_level_data->getObjectives();
+    for (const auto& obj : objectives) {
+        if (obj.objective_type == "collect_vegetables" && !obj.isCompleted()) {
+            return false;
         }
+    }
+    return true;
+}
+
+QPointF GameScene::interpolatedPlayerPos() const
+{
+    const player& pl = world.getPlayer();
+    const QPointF prevPos = world.getPrevPlayerPos();
+    return prevPos + (pl.pos() - prevPos) * render_alpha;
+}
+
+QPixmap* GameScene::staticChunk(int chunkX, int chunkY)
+{
+    if (!current_level_data) return nullptr;
+    
+    const int key = chunkY * current_level_data->getChunkColumns() + chunkX;
+    if (QPixmap* cached = static_chunks.object(key)) {
+        return cached;
+    }
+    
+    const int chunkPx = CHUNK_TILES * B0;
+    const QRectF chunkRect(chunkX * chunkPx, chunkY * chunkPx, chunkPx, chunkPx);
+    
+    // 与分块相交的静态元素（跨分块的元素在每个分块中各画一部分）
+    const auto& elements = current_level_data->getGameElements();
+    world.queryElements(chunkRect, chunk_elements);
+    chunk_elements.erase(std::remove_if(chunk_elements.begin(), chunk_elements.end(), [&](int i) {
+        const auto& element = elements[i];
+        return !isStaticLayerElement(element.element_type) || world.isCollected(i) ||
+               !chunkRect.intersects(QRectF(element.position.x(), element.position.y(),
+                                            element.size.x(), element.size.y()));
+    }), chunk_elements.end());
+    
+    // 没有任何静态内容的分块缓存为空图像，不占用贴图内存
+    QPixmap* chunk = new QPixmap();
+    if (!current_level_data->isChunkEmpty(chunkX, chunkY) || !chunk_elements.isEmpty()) {
+        const qreal dpr = devicePixelRatioF();
+        *chunk = QPixmap(QSize(chunkPx, chunkPx) * dpr);
+        chunk->setDevicePixelRatio(dpr);
+        chunk->fill(Qt::transparent);
         
-        if (!shouldDraw) continue;
+        QPainter painter(chunk);
+        painter.translate(-chunkRect.topLeft());
         
-        if (!texture.isNull() && element.element_type == GameElementType::Vegetable) {
-            painter.drawPixmap(x, y, w, h, texture);
-        } else if (!texture.isNull() && element.element_type == GameElementType::LevelExit) {
-            // 检查是否收集了所有青菜
-            bool allVegetablesCollected = true;
-            const auto& objectives = current_level_data->getObjectives();
-            for (const auto& obj : objectives) {
-                if (obj.objective_type == "collect_vegetables" && !obj.isCompleted()) {
-                    allVegetablesCollected = false;
-                    break;
+        // 实心方块
+        const int firstCol = chunkX * CHUNK_TILES;
+        const int firstRow = chunkY * CHUNK_TILES;
+        for (int i = firstCol; i < firstCol + CHUNK_TILES; i++) {
+            for (int j = firstRow; j < firstRow + CHUNK_TILES; j++) {
+                if (world.isSolid(i, j)) {
+                    painter.drawPixmap(i * B0, j * B0, W, W, block5);
                 }
             }
-            
-            if (allVegetablesCollected) {
-                // 青菜收集完毕，正常显示终点
-                painter.drawPixmap(x, y, w, h, texture);
+        }
+        
+        // 静态元素
+        for (int i : chunk_elements) {
+            drawStaticElement(painter, elements[i]);
+        }
+    }
+    
+    static_chunks.insert(key, chunk, 1);
+    return static_chunks.object(key);
+}
+
+void GameScene::onLevelDataLoaded()
+{
+    invalidateStaticLayer();
+    if (current_level_data) {
+        camera.setWorldSize(QSizeF(current_level_data->getWidth() * B0,
+                                   current_level_data->getHeight() * B0));
+    }
+}
+
+void GameScene::drawStaticElement(QPainter& painter, const GameElement& element)
+{
+    QPixmap texture;
+    bool drawRect = false;
+    QColor rectColor;
+    switch (element.element_type) {
+    case GameElementType::LevelExit:
+        texture = exit_texture;
+        break;
+    case GameElementType::Water:
+        drawRect = true;
+        rectColor = QColor(0, 120, 255, 180);
+        if (!water_texture.isNull()) texture = water_texture;
+        break;
+    case GameElementType::Lava:
+        drawRect = true;
+        rectColor = QColor(255, 60, 0, 200);
+        if (!lava_texture.isNull()) texture = lava_texture;
+        break;
+    case GameElementType::ArrowTrap:
+        {
+            // 根据箭机关方向（加载时已解析）选择对应纹理
+            const ArrowDirection direction = element.arrow.direction;
+            const QPixmap& sprite = arrow_trap_sprites[int(direction)];
+            if (!sprite.isNull()) {
+                texture = sprite;
             } else {
-                // 青菜未收集完毕，半透明显示终点，表示无法通关
-                painter.setOpacity(0.3);
-                painter.drawPixmap(x, y, w, h, texture);
-                painter.setOpacity(1.0); // 恢复透明度
+                // 如果没有对应方向的纹理，使用默认颜色
+                drawRect = true;
+                rectColor = QColor(180, 180, 180, 200);
             }
-        } else if (!texture.isNull() && (element.element_type == GameElementType::Water || element.element_type == GameElementType::Lava || element.element_type == GameElementType::ArrowTrap)) {
-            painter.drawPixmap(x, y, w, h, texture);
-        } else if (!texture.isNull() && (element.element_type == GameElementType::HorizontalPlatform || 
-                                        element.element_type == GameElementType::VerticalPlatform ||
-                                        element.element_type == GameElementType::Switch ||
-                                        element.element_type == GameElementType::Door)) {
-            painter.drawPixmap(x, y, w, h, texture);
-        } else if (drawRect) {
-            painter.setPen(Qt::NoPen);
-            painter.setBrush(QBrush(rectColor));
-            painter.drawRect(QRect(x, y, w, h));
         }
+        break;
+    default:
+        return;
+    }
+    
+    const int x = static_cast<int>(element.position.x());
+    const int y = static_cast<int>(element.position.y());
+    const int w = static_cast<int>(element.size.x());
+    const int h = static_cast<int>(element.size.y());
+    
+    if (!texture.isNull() && element.element_type == GameElementType::LevelExit) {
+        // 青菜未收集完毕时半透明显示终点，表示无法通关
+        painter.setOpacity(static_layer_exit_unlocked ? 1.0 : 0.3);
+        painter.drawPixmap(x, y, w, h, texture);
+        painter.setOpacity(1.0);
+    } else if (!texture.isNull()) {
+        painter.drawPixmap(x, y, w, h, texture);
+    } else if (drawRect) {
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QBrush(rectColor));
+        painter.drawRect(QRect(x, y, w, h));
     }
 }
 
@@ -1016,7 +944,7 @@ void GameScene::pauseGame()
     }
     
     showPauseMenu();
-    qDebug() << "Game paused";
+    qCDebug(lcLevel) << "Game paused";
 }
 
 void GameScene::resumeGame()
@@ -1025,7 +953,7 @@ void GameScene::resumeGame()
     
     is_paused = false;
     hidePauseMenu();
-    qDebug() << "Game resumed";
+    qCDebug(lcLevel) << "Game resumed";
 }
 
 void GameScene::createPauseMenu()
@@ -1148,46 +1076,30 @@ void GameScene::resetLevel()
         }
     }
     
-    // 清空已收集物品
-    collected_items.clear();
-    
-    // 清空箭矢
-    projectiles.clear();
+    // 模拟世界回到关卡初始状态（已收集物品、箭矢、平台、开关门、玩家、目标进度）
+    world.reset();
+    invalidateStaticLayer();
 
     // +++ 新增：清空残影
     afterimages.clear();
     lastAfterimageTime = 0;
-
-    // 重置移动平台和开关门状态
-    moving_platforms.clear();
-    switch_doors.clear();
     
     // 重置游戏状态
     begin = false;
     leftpress = false;
     rightpress = false;
+    jump_requested = false;
+    dash_requested = false;
     is_dead = false;
-    tick_counter = 0;
     
-    // 重置水域状态和移动速度
-    is_in_water = false;
-    pl.resetMoveSpeed();
+    // 目标进度与教学提示回到初始状态
+    updateObjectiveDisplay();
+    updateTutorialHints();
     
-    // 重置玩家按键状态
-    pl.resetKeyStates();
+    // 新的一局从头录像
+    replay_recorder.begin(current_level_data ? current_level_data->getFilePath() : QString());
     
-    // 重置玩家位置和目标进度（如果有当前关卡数据）
-    if (current_level_data) {
-        QPointF startPos = current_level_data->getPlayerStartPosition();
-        pl.x = startPos.x();
-        pl.y = startPos.y();
-        pl.vx = 0;
-        pl.vy = 0;
-        
-        // 重置关卡目标进度
-        current_level_data->resetObjectiveProgress();
-    }
-    qDebug() << "关卡状态已重置，包括胜利界面";
+    qCDebug(lcLevel) << "关卡状态已重置，包括胜利界面";
 }
 
 void GameScene::restartLevel()
@@ -1204,6 +1116,37 @@ void GameScene::restartLevel()
     }
 }
 
+bool GameScene::playReplay(const Replay& replay)
+{
+    replay_playback = replay;
+    is_replaying = true;
+    if (!loadLevelFromFile(replay.getLevelPath())) {
+        is_replaying = false;
+        return false;
+    }
+    if (Replay::hashLevelFile(replay.getLevelPath()) != replay.getLevelHash()) {
+        showGameMessage("关卡文件已修改，回放结果可能不一致", 3000);
+    }
+    return true;
+}
+
+void GameScene::finishReplay()
+{
+    const quint64 stateHash = world.computeStateHash();
+    if (is_replaying) {
+        const bool matches = replay_playback.hasFinalStateHash() &&
+                             replay_playback.getFinalStateHash() == stateHash;
+        qCDebug(lcLevel) << "回放结束，状态哈希" << (matches ? "一致" : "不一致");
+        return;
+    }
+    
+    replay_recorder.finish(stateHash);
+    const QString replayPath = Replay::defaultSavePath();
+    if (replay_recorder.saveToFile(replayPath)) {
+        qCDebug(lcLevel) << "录像已保存：" << replayPath;
+    }
+}
+
 void GameScene::gamewin()
 {
     // 停止游戏定时器
@@ -1213,8 +1156,8 @@ void GameScene::gamewin()
     int currentLevelIndex = LevelManager::getInstance().getCurrentLevelIndex();
     LevelManager::getInstance().markLevelCompleted(currentLevelIndex);
     
-    // 保存游戏进度并解锁下一关
-    saveGameProgress(currentLevelIndex + 1);  // 传入当前通关的关卡编号（从0基索引转换为1基编号）
+    // 解锁下一关（关卡选择界面固定显示6关，不受已有关卡文件数量限制）
+    unlockLevel(currentLevelIndex + 1);
     
     // 创建胜利界面背景
     QWidget* winWidget = new QWidget(this);
@@ -1323,7 +1266,7 @@ void GameScene::gamewin()
     winWidget->show();
     winContainer->show();
     
-    qDebug() << "关卡" << currentLevelIndex << "通关成功！";
+    qCDebug(lcLevel) << "关卡" << currentLevelIndex << "通关成功！";
 }
 
 void GameScene::gameover()
@@ -1368,7 +1311,6 @@ void GameScene::gameover()
             loadLevelInternal(idx);
         }
         is_dead = false;
-        projectiles.clear();
     });
     btns->addWidget(retry);
     
@@ -1394,498 +1336,36 @@ void GameScene::gameover()
 
 void GameScene::showGameMessage(const QString& message, int duration)
 {
-    // 如果tutorial_label存在，使用它来显示消息
-    if (tutorial_label) {
-        tutorial_label->setText(message);
-        tutorial_label->setStyleSheet(
-            "QLabel {"
-            "background-color: rgba(255, 255, 0, 200);"
-            "color: black;"
-            "font-size: 18px;"
-            "font-weight: bold;"
-            "padding: 10px;"
-            "border-radius: 8px;"
-            "border: 2px solid orange;"
-            "}"
-        );
-        tutorial_label->show();
-        
-        // 设置定时器自动隐藏消息
-        QTimer::singleShot(duration, [this]() {
-            if (tutorial_label) {
-                tutorial_label->hide();
-            }
-        });
-    }
+    // 消息在 paintEvent 中绘制；每tick重复的同一消息只延长显示时间
+    const bool alreadyShown = hud_message_duration > 0 &&
+                              hud_message_timer.elapsed() < hud_message_duration &&
+                              hud_message_text.text() == message;
+    setHudText(hud_message_text, message);
+    hud_message_duration = duration;
+    hud_message_timer.start();
+    if (alreadyShown) return;
+    
+    // 到期后重绘一次，暂停或结束时也能及时隐藏
+    QTimer::singleShot(duration, this, [this]() { update(); });
+    update();
 }
 
 void GameScene::saveGameProgress(int levelIndex)
 {
-    // 获取游戏进度保存路径 - 使用智能路径检测
-    QString saveDir = getDataDirectory();
-    QDir dir;
-    if (!dir.exists(saveDir)) {
-        dir.mkpath(saveDir);
-    }
-    
-    QString saveFilePath = saveDir + "/game_progress.json";
-    
-    // 先加载现有进度
-    QJsonObject saveObject = loadGameProgress();
-    
-    // 更新通关关卡列表
-    QJsonArray unlockedLevels = saveObject["unlockedLevels"].toArray();
-    
-    // 确保当前关卡在已解锁列表中
-    bool levelExists = false;
-    for (const QJsonValue& value : unlockedLevels) {
-        if (value.toInt() == levelIndex) {
-            levelExists = true;
-            break;
-        }
-    }
-    
-    if (!levelExists) {
-        unlockedLevels.append(levelIndex);
-    }
-    
-    // 解锁下一关（如果存在）
-    int nextLevel = levelIndex + 1;
-    bool nextLevelExists = false;
-    for (const QJsonValue& value : unlockedLevels) {
-        if (value.toInt() == nextLevel) {
-            nextLevelExists = true;
-            break;
-        }
-    }
-    
-    if (!nextLevelExists) {
-        unlockedLevels.append(nextLevel);
-        qDebug() << "解锁下一关：" << nextLevel;
-    }
-    
-    // 更新保存对象
-    saveObject["unlockedLevels"] = unlockedLevels;
-    saveObject["lastLevel"] = levelIndex;
-    saveObject["saveTime"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-    
-    // 写入文件
-    QJsonDocument saveDoc(saveObject);
-    QFile saveFile(saveFilePath);
-    
-    if (saveFile.open(QIODevice::WriteOnly)) {
-        saveFile.write(saveDoc.toJson());
-        saveFile.close();
-        qDebug() << "游戏进度已保存，关卡：" << levelIndex;
-    } else {
-        qDebug() << "无法保存游戏进度文件：" << saveFilePath;
-    }
-}
-
-QJsonObject GameScene::loadGameProgress()
-{
-    QString saveDir = getDataDirectory();
-    QString saveFilePath = saveDir + "/game_progress.json";
-    
-    QFile saveFile(saveFilePath);
-    if (!saveFile.exists()) {
-        // 如果文件不存在，创建默认进度（第1关解锁）
-        QJsonObject defaultProgress;
-        QJsonArray unlockedLevels;
-        unlockedLevels.append(1);  // 第1关默认解锁
-        defaultProgress["unlockedLevels"] = unlockedLevels;
-        defaultProgress["lastLevel"] = 0;
-        defaultProgress["saveTime"] = QDateTime::currentDateTime().toString(Qt::ISODate);
-        
-        qDebug() << "创建默认游戏进度，第1关解锁";
-        return defaultProgress;
-    }
-    
-    if (saveFile.open(QIODevice::ReadOnly)) {
-        QByteArray saveData = saveFile.readAll();
-        saveFile.close();
-        
-        QJsonDocument loadDoc = QJsonDocument::fromJson(saveData);
-        QJsonObject progress = loadDoc.object();
-        
-        // 确保有unlockedLevels字段
-        if (!progress.contains("unlockedLevels")) {
-            QJsonArray unlockedLevels;
-            unlockedLevels.append(1);  // 第1关默认解锁
-            progress["unlockedLevels"] = unlockedLevels;
-        }
-        
-        return progress;
-    } else {
-        qDebug() << "无法读取游戏进度文件：" << saveFilePath;
-        // 返回默认进度
-        QJsonObject defaultProgress;
-        QJsonArray unlockedLevels;
-        unlockedLevels.append(1);
-        defaultProgress["unlockedLevels"] = unlockedLevels;
-        defaultProgress["lastLevel"] = 0;
-        return defaultProgress;
-    }
+    // 进度由 ProgressStore 在内存中更新，稍后在后台合并写入
+    ProgressStore& progress = ProgressStore::getInstance();
+    progress.unlockLevel(levelIndex);
+    progress.setLastLevel(levelIndex);
 }
 
 bool GameScene::isLevelUnlocked(int levelIndex)
 {
-    QJsonObject progress = loadGameProgress();
-    QJsonArray unlockedLevels = progress["unlockedLevels"].toArray();
-    
-    for (const QJsonValue& value : unlockedLevels) {
-        if (value.toInt() == levelIndex) {
-            return true;
-        }
-    }
-    
-    return false;
+    return ProgressStore::getInstance().isLevelUnlocked(levelIndex);
 }
 
 void GameScene::unlockLevel(int levelIndex)
 {
-    QJsonObject progress = loadGameProgress();
-    QJsonArray unlockedLevels = progress["unlockedLevels"].toArray();
-    
-    // 检查关卡是否已经解锁
-    bool alreadyUnlocked = false;
-    for (const QJsonValue& value : unlockedLevels) {
-        if (value.toInt() == levelIndex) {
-            alreadyUnlocked = true;
-            break;
-        }
-    }
-    
-    if (!alreadyUnlocked) {
-        unlockedLevels.append(levelIndex);
-        progress["unlockedLevels"] = unlockedLevels;
-        
-        // 保存更新后的进度
-        QString saveDir = getDataDirectory();
-        QDir dir;
-        if (!dir.exists(saveDir)) {
-            dir.mkpath(saveDir);
-        }
-        
-        QString saveFilePath = saveDir + "/game_progress.json";
-        QJsonDocument saveDoc(progress);
-        QFile saveFile(saveFilePath);
-        
-        if (saveFile.open(QIODevice::WriteOnly)) {
-            saveFile.write(saveDoc.toJson());
-            saveFile.close();
-            qDebug() << "关卡" << levelIndex << "已解锁";
-        } else {
-            qDebug() << "无法保存关卡解锁进度";
-        }
-    }
-}
-
-// === 移动平台和开关门方法实现 ===
-
-void GameScene::initializeMovingPlatforms()
-{
-    moving_platforms.clear();
-    
-    if (!current_level_data) return;
-    
-    const auto& elements = current_level_data->getGameElements();
-    for (int i = 0; i < elements.size(); ++i) {
-        const auto& element = elements[i];
-        
-        if (element.element_type == GameElementType::HorizontalPlatform ||
-            element.element_type == GameElementType::VerticalPlatform) {
-            
-            MovingPlatformState platform;
-            platform.element_index = i;
-            platform.current_pos = element.position;
-            platform.start_pos = element.position;
-            platform.moving_to_end = true;
-            
-            // 从属性中获取终点位置
-            if (element.properties.contains("end_x") && element.properties.contains("end_y")) {
-                platform.end_pos = QPointF(
-                    element.properties["end_x"].toDouble(),
-                    element.properties["end_y"].toDouble()
-                );
-            } else {
-                // 默认终点位置（如果没有指定）
-                if (element.element_type == GameElementType::HorizontalPlatform) {
-                    platform.end_pos = element.position + QPointF(B0 * 3, 0); // 向右移动3格
-                } else {
-                    platform.end_pos = element.position + QPointF(0, B0 * 3); // 向下移动3格
-                }
-            }
-            
-            // 计算移动速度（每秒移动1格）
-            QPointF direction = platform.end_pos - platform.start_pos;
-            float distance = sqrt(direction.x() * direction.x() + direction.y() * direction.y());
-            if (distance > 0) {
-                float speed = B0 / 60.0f; // 每帧移动的距离（60FPS）
-                platform.velocity = direction * (speed / distance);
-            } else {
-                platform.velocity = QPointF(0, 0);
-            }
-            
-            moving_platforms.append(platform);
-        }
-    }
-}
-
-void GameScene::updateMovingPlatforms()
-{
-    for (auto& platform : moving_platforms) {
-        if (platform.velocity.x() == 0 && platform.velocity.y() == 0) continue;
-        
-        // 更新位置
-        platform.current_pos += platform.velocity;
-        
-        // 检查是否到达终点
-        QPointF target = platform.moving_to_end ? platform.end_pos : platform.start_pos;
-        QPointF diff = target - platform.current_pos;
-        
-        // 如果接近目标点，切换方向
-        if (abs(diff.x()) < 2.0f && abs(diff.y()) < 2.0f) {
-            platform.current_pos = target;
-            platform.moving_to_end = !platform.moving_to_end;
-            platform.velocity = -platform.velocity;
-        }
-    }
-}
-
-void GameScene::initializeSwitchDoors()
-{
-    switch_doors.clear();
-    
-    if (!current_level_data) return;
-    
-    const auto& elements = current_level_data->getGameElements();
-    
-    // 查找所有开关和门的配对
-    for (int i = 0; i < elements.size(); ++i) {
-        if (elements[i].element_type == GameElementType::Switch) {
-            // 查找对应的门
-            for (int j = 0; j < elements.size(); ++j) {
-                if (elements[j].element_type == GameElementType::Door) {
-                    // 检查是否有配对信息
-                    QString switchId = elements[i].properties.value("switch_id").toString();
-                    if (switchId.isEmpty()) switchId = QString::number(i);
-                    QString doorId = elements[j].properties.value("door_id").toString();
-                    if (doorId.isEmpty()) doorId = QString::number(j);
-                    
-                    if (switchId == doorId || 
-                        (elements[i].properties.contains("paired_door") && 
-                         elements[i].properties["paired_door"].toInt() == j)) {
-                        
-                        SwitchDoorState switchDoor;
-                        switchDoor.switch_element_index = i;
-                        switchDoor.door_element_index = j;
-                        switchDoor.is_activated = false;
-                        switchDoor.door_is_open = false;
-                        
-                        switch_doors.append(switchDoor);
-                        break;
-                    }
-                }
-            }
-        }
-    }
-}
-
-void GameScene::checkSwitchCollisions()
-{
-    if (!current_level_data) return;
-    
-    const auto& elements = current_level_data->getGameElements();
-    QRectF playerRect(pl.x, pl.y, pl.w, pl.h);
-    
-    for (auto& switchDoor : switch_doors) {
-        if (switchDoor.is_activated) continue;
-        
-        const auto& switchElement = elements[switchDoor.switch_element_index];
-        QRectF switchRect(switchElement.position.x(), switchElement.position.y(),
-                         switchElement.size.x(), switchElement.size.y());
-        
-        if (playerRect.intersects(switchRect)) {
-            activateSwitch(switch_doors.indexOf(switchDoor));
-        }
-    }
-}
-
-void GameScene::checkMovingPlatformCollisions()
-{
-    if (!current_level_data) return;
-
-    QRectF playerRect(pl.x, pl.y, pl.w, pl.h);
-    bool isSupported = false; // 标记玩家本帧是否被任何平面支撑
-
-    // 默认玩家不在移动平台上，除非检测到
-    pl.onMovingPlatform = false;
-
-    for (int i = 0; i < moving_platforms.size(); ++i) {
-        const auto& platform = moving_platforms[i];
-        const auto& element = current_level_data->getGameElements()[platform.element_index];
-        QRectF platformRect(platform.current_pos.x(), platform.current_pos.y(), element.size.x(), element.size.y());
-
-        // 优化检测条件：只关心玩家是否在平台上方，并且即将或正在接触
-        bool isHorizontallyAligned = playerRect.right() > platformRect.left() && playerRect.left() < platformRect.right();
-        qreal vertical_tolerance = 5.0;
-        bool isVerticallyClose = (pl.y + pl.h) >= platformRect.top() && (pl.y + pl.h) <= (platformRect.top() + vertical_tolerance);
-
-        if (isHorizontallyAligned && isVerticallyClose) {
-            // 玩家在平台上方
-            pl.y = platformRect.top() - pl.h; // 精确地将玩家放在平台表面
-            
-            // 关键修复：只有当玩家向下运动或静止时才重置跳跃状态
-            // 这样可以保证玩家的跳跃意图不被打断
-            if (pl.v0 >= 0) {  // 向下运动或静止
-                pl.v0 = 0;
-                pl.isJump = false;
-            }
-            // 如果玩家正在向上跳跃（v0 < 0），不重置跳跃状态，让玩家继续跳跃
-            
-            isSupported = true; // 玩家被支撑
-            pl.onMovingPlatform = true; // 确认在移动平台上
-            pl.onGround = true; // 强制设置onGround为true，确保可以跳跃
-
-            pl.resetAirDash(); // +++ 新增：在移动平台落地时，重置空中冲刺
-
-            // 如果这是玩家新接触的平台，或者平台索引变了，则更新相对位置
-            if (pl.currentPlatformIndex != i) {
-                pl.currentPlatformIndex = i;
-                pl.platformRelativeX = pl.x - platform.current_pos.x();
-                pl.platformRelativeY = pl.y - (platform.current_pos.y() - pl.h);
-            }
-            
-            // 既然已经找到了支撑平台，就没必要再检查其他移动平台了
-            break; 
-        }
-        // （可选）在这里可以补充处理水平碰撞和头部碰撞的逻辑
-    }
-
-    // 如果没有被任何移动平台支撑，则检查静态地面
-    if (!isSupported) {
-        pl.currentPlatformIndex = -1; // 不在任何移动平台上
-        if (pl.is_ground()) {
-            isSupported = true;
-        }
-    }
-
-    // 最终根据isSupported状态更新onGround
-    pl.onGround = isSupported;
-}
-
-void GameScene::activateSwitch(int switch_index)
-{
-    if (switch_index < 0 || switch_index >= switch_doors.size()) return;
-    
-    auto& switchDoor = switch_doors[switch_index];
-    if (switchDoor.is_activated) return;
-    
-    switchDoor.is_activated = true;
-    switchDoor.door_is_open = true;
-    
-    // 可以在这里添加音效或视觉效果
-    qDebug() << "Switch activated! Door opened.";
-}
-
-bool GameScene::checkDoorCollision(const QRectF& playerRect)
-{
-    if (!current_level_data) return false;
-    
-    const auto& elements = current_level_data->getGameElements();
-    
-    for (const auto& switchDoor : switch_doors) {
-        // 只检查关闭的门
-        if (switchDoor.door_is_open) continue;
-        
-        const auto& doorElement = elements[switchDoor.door_element_index];
-        QRectF doorRect(doorElement.position.x(), doorElement.position.y(),
-                       doorElement.size.x(), doorElement.size.y());
-        
-        if (playerRect.intersects(doorRect)) {
-            return true; // 与关闭的门发生碰撞
-        }
-    }
-    
-    return false; // 没有碰撞
-}
-
-void GameScene::handlePlatformFollowing()
-{
-    // 如果玩家不在移动平台上，重置相关状态
-    if (!pl.onMovingPlatform) {
-        pl.currentPlatformIndex = -1;
-        pl.platformRelativeX = 0.0;
-        pl.platformRelativeY = 0.0;
-        return;
-    }
-    
-    // 如果玩家在移动平台上，处理相对位置逻辑
-    if (pl.currentPlatformIndex >= 0 && pl.currentPlatformIndex < moving_platforms.size()) {
-        const auto& platform = moving_platforms[pl.currentPlatformIndex];
-        const auto& element = current_level_data->getGameElements()[platform.element_index];
-
-        // 检查玩家是否在主动移动
-        bool isActivelyMoving = pl.getLeftPressed() || pl.getRightPressed();
-        bool isActivelyJumping = pl.isJump && pl.v0 < 0; // 正在向上跳跃
-
-        // 处理水平跟随
-        if (isActivelyMoving) {
-            // 玩家主动移动时，更新相对位置
-            pl.platformRelativeX = pl.x - platform.current_pos.x();
-        } else {
-            // 玩家没有主动移动时，保持相对位置不变
-            // 根据平台的当前位置和相对位置计算玩家的绝对位置
-            double newPlayerX = platform.current_pos.x() + pl.platformRelativeX;
-
-            // 检查边界，确保玩家不会超出平台范围太远
-            double platformLeft = platform.current_pos.x();
-            double platformRight = platform.current_pos.x() + element.size.x();
-            double playerLeft = newPlayerX;
-            double playerRight = newPlayerX + pl.w;
-
-            // 如果玩家完全在平台范围内或者有合理的重叠，则跟随平台
-            if (playerRight > platformLeft && playerLeft < platformRight) {
-                pl.x = newPlayerX;
-            } else {
-                // 玩家离开平台范围，停止跟随
-                pl.onMovingPlatform = false;
-                pl.currentPlatformIndex = -1;
-                pl.platformRelativeX = 0.0;
-                pl.platformRelativeY = 0.0;
-                return;
-            }
-        }
-
-        // 处理垂直跟随：与水平跟随逻辑保持一致
-        if (isActivelyJumping) {
-            // 玩家主动跳跃时，更新相对位置
-            pl.platformRelativeY = pl.y - (platform.current_pos.y() - pl.h);
-        } else {
-            // 玩家没有主动跳跃时，保持相对位置不变
-            // 根据平台的当前位置和相对位置计算玩家的绝对位置
-            double newPlayerY = (platform.current_pos.y() - pl.h) + pl.platformRelativeY;
-
-            // 检查边界，确保玩家不会超出平台范围太远
-            double platformTop = platform.current_pos.y();
-            double platformBottom = platform.current_pos.y() + element.size.y();
-            double playerTop = newPlayerY;
-            double playerBottom = newPlayerY + pl.h;
-
-            // 如果玩家完全在平台范围内或者有合理的重叠，则跟随平台
-            if (playerBottom > platformTop && playerTop < platformBottom) {
-                pl.y = newPlayerY;
-            } else {
-                // 玩家离开平台范围，停止跟随
-                pl.onMovingPlatform = false;
-                pl.currentPlatformIndex = -1;
-                pl.platformRelativeX = 0.0;
-                pl.platformRelativeY = 0.0;
-                return;
-            }
-        }
-    }
+    ProgressStore::getInstance().unlockLevel(levelIndex);
 }
 
 // +++ 新增：实现更新残影的函数 (放在 GameScene.cpp 的末尾)
@@ -1901,11 +1381,12 @@ void GameScene::updateAfterimages()
                                      }), afterimages.end());
 
     // 2. 如果玩家正在冲刺，则按间隔添加新的残影
+    player& pl = world.getPlayer();
     if (pl.getIsDashing()) {
         if (now - lastAfterimageTime > AFTERIMAGE_INTERVAL) {
             Afterimage newImg;
-            newImg.frame = pl.getCurrentAnimationFrame(); // 捕捉当前动画帧
-            newImg.rect = QRectF(pl.x, pl.y, pl.w, pl.h); // 捕捉当前位置
+            newImg.frame = pl.getCurrentAnimationFrame(); // 捕捉当前动画帧（图集中的源矩形）
+            newImg.rect = pl.rect(); // 捕捉当前位置
             newImg.spawnTime = now;
 
             afterimages.append(newImg); // 添加到列表中
@@ -7,6 +7,7 @@
 #include <QResizeEvent>
 #include <QLabel>
 #include <QFont>
+#include <QStaticText>
 #include <QPushButton>
 #include "player.h"
 #include "qdebug.h"
@@ -17,6 +18,10 @@
 #include "Config.h"
 #include "LevelData.h"
 #include "LevelManager.h"
+#include "SimulationWorld.h"
+#include "Replay.h"
+#include "Camera.h"
+#include <QCache>
 #include <QElapsedTimer>
 #include <QJsonObject>
 class BackGround
@@ -40,6 +45,8 @@ namespace Ui {
 class GameScene;
 }
 
+class LionAnimation;
+
 class GameScene : public QWidget
 {
     Q_OBJECT
@@ -50,7 +57,7 @@ public:
 private:
     // +++ 新增：残影结构体
     struct Afterimage {
-        QPixmap frame;      // 捕捉的帧
+        QRect frame;        // 捕捉的帧（动画图集中的源矩形）
         QRectF rect;        // 当时的位置
         qint64 spawnTime;   // 生成时间
     };
@@ -67,8 +74,13 @@ private:
 public:
     QTimer Timer;
     BackGround background;
-    player pl;
+    SimulationWorld world;                  ///< 游戏模拟（玩家、地图、机关状态）
+    LionAnimation* lion_animation;          ///< 玩家动画（挂接到world中的玩家）
     QPixmap block5;
+    QCache<int, QPixmap> static_chunks;     ///< 静态图层分块缓存（实心方块与静态元素，按分块索引LRU淘汰）
+    bool static_layer_exit_unlocked = false; ///< 缓存中的出口是否按“可通关”状态绘制
+    QVector<int> chunk_elements;            ///< 构建分块时的元素查询结果缓冲
+    Camera camera;                          ///< 跟随玩家的摄像机
     QFont font;
     QLabel *label1,*label2;
     QLabel *labelblood1,*labelblood2;
@@ -78,22 +90,29 @@ public:
     bool leftpress=0;
     double time=0.000001;
     bool rightpress=0;
+    bool jump_requested=false;              ///< 自上一tick以来按下过 K
+    bool dash_requested=false;              ///< 自上一tick以来按下过 Shift
     bool begin=false;
     
     // === 新增：关卡系统相关 ===
     LevelData* current_level_data;          ///< 当前关卡数据
-    QVector<GameElement> collected_items;   ///< 已收集的物品
-    QLabel* objective_label;                ///< 目标显示标签
-    QLabel* tutorial_label;                 ///< 教学提示标签
+    QVector<int> visible_elements;          ///< 绘制时可见区域元素查询结果缓冲
+    static constexpr int HUD_HINT_WIDTH = 400;      ///< 教学提示与消息框宽度
+    static constexpr int HUD_MESSAGE_PADDING = 10;  ///< 消息框内边距
+    QStaticText hud_objective_text;         ///< 目标文字（目标进度变化时才重新排版）
+    QStaticText hud_hint_text;              ///< 教学提示文字
+    QStaticText hud_message_text;           ///< 临时消息文字
+    QFont hud_objective_font;               ///< 目标文字字体
+    QFont hud_hint_font;                    ///< 教学提示字体
+    QFont hud_message_font;                 ///< 临时消息字体
+    QElapsedTimer hud_message_timer;        ///< 临时消息显示计时
+    int hud_message_duration = 0;           ///< 临时消息显示时长（毫秒），0表示没有消息
     QPixmap vegetable_texture;              ///< 青菜纹理
     QPixmap exit_texture;                   ///< 出口纹理
     QPixmap water_texture;                  ///< 水纹理（可为空使用颜色）
     QPixmap lava_texture;                   ///< 岩浆纹理（可为空使用颜色）
-    QPixmap arrow_texture;                  ///< 箭矢纹理（可为空使用颜色）
-    QPixmap arrow_trap_right_texture;       ///< 向右箭机关纹理
-    QPixmap arrow_trap_left_texture;        ///< 向左箭机关纹理
-    QPixmap arrow_trap_up_texture;          ///< 向上箭机关纹理
-    QPixmap arrow_trap_down_texture;        ///< 向下箭机关纹理
+    QPixmap arrow_sprites[4];               ///< 箭矢贴图（按ArrowDirection索引，构造时预先旋转/镜像）
+    QPixmap arrow_trap_sprites[4];          ///< 箭机关贴图（按ArrowDirection索引，可为空使用颜色）
     QPushButton* back_button;               ///< 返回按钮
     
     // === 移动平台和开关门纹理 ===
@@ -105,9 +124,16 @@ public:
     // 计时与状态
     QElapsedTimer level_timer;              ///< 关卡计时器
     bool is_dead = false;                   ///< 玩家死亡状态
-    bool is_in_water = false;               ///< 玩家在水中（减速）
-    int water_slow_counter = 0;             ///< 水减速计数
-    int tick_counter = 0;                   ///< 场景tick计数
+    
+    // === 固定步长模拟 ===
+    QElapsedTimer frame_clock;              ///< 两次定时器唤醒之间的真实耗时
+    qint64 tick_accumulator_ns = 0;         ///< 尚未模拟的累计时间（纳秒）
+    double render_alpha = 0.0;              ///< 渲染插值系数 [0, 1)
+    
+    // === 录像与回放 ===
+    Replay replay_recorder;                 ///< 当前一局的输入录像
+    Replay replay_playback;                 ///< 正在回放的录像
+    bool is_replaying = false;              ///< 是否处于回放模式（忽略键盘输入）
     
     // === 暂停功能相关 ===
     bool is_paused = false;                 ///< 游戏是否暂停
@@ -116,37 +142,14 @@ public:
     QPushButton* restart_button = nullptr;  ///< 重新开始按钮
     QPushButton* main_menu_button = nullptr; ///< 返回主菜单按钮
     
-    // 箭矢投射物
-    struct Projectile { QPointF pos; QPointF vel; QPointF size; bool active; };
-    QVector<Projectile> projectiles;
-    
-    // === 移动平台状态 ===
-    struct MovingPlatformState {
-        QPointF current_pos;        ///< 当前位置
-        QPointF start_pos;          ///< 起始位置
-        QPointF end_pos;            ///< 结束位置
-        QPointF velocity;           ///< 移动速度
-        bool moving_to_end;         ///< 是否正在向终点移动
-        int element_index;          ///< 对应的游戏元素索引
-    };
-    QVector<MovingPlatformState> moving_platforms;
-    
-    // === 开关门状态 ===
-    struct SwitchDoorState {
-        bool is_activated = false;          ///< 开关是否被激活
-        int switch_element_index = -1;   ///< 开关元素索引
-        int door_element_index = -1;     ///< 门元素索引
-        bool door_is_open = false;          ///< 门是否打开
-        
-        bool operator==(const SwitchDoorState& other) const {
-            return switch_element_index == other.switch_element_index &&
-                   door_element_index == other.door_element_index;
-        }
-    };
-    QVector<SwitchDoorState> switch_doors;
     void init();
-    void mapInit();
     void gameStart();
+    
+    /**
+     * @brief 采集本tick输入，推进一个固定步长（GAME_TICK 毫秒）并处理模拟事件
+     * @return bool 模拟是否继续（胜利或死亡后返回false）
+     */
+    bool simulateTick();
     void gamewin();
     void gameover();
     void updatePosition();
@@ -174,6 +177,13 @@ public:
      */
     void resetLevel();
     void restartLevel();
+    
+    /**
+     * @brief 加载录像对应的关卡并按录像输入逐tick回放
+     * @param replay 录像
+     * @return bool 关卡是否加载成功
+     */
+    bool playReplay(const Replay& replay);
 
 signals:
     /**
@@ -202,25 +212,32 @@ private:
     bool loadLevelInternal(int levelIndex);
     
     /**
-     * @brief 检查玩家与游戏元素的碰撞
+     * @brief 一局结束时保存录像或校验回放结果
      */
-    void checkGameElementCollisions();
+    void finishReplay();
     
     /**
-     * @brief 收集游戏物品
-     * @param element 游戏元素
+     * @brief 更新目标显示（只在目标进度变化或关卡重置时调用）
      */
-    void collectItem(const GameElement& element);
+    void updateObjectiveDisplay();
     
     /**
-     * @brief 更新目标显示
+     * @brief 更新教学提示（只在游戏状态或目标进度变化时调用）
      */
-    void updateObjectiveDisplay();
+    void updateTutorialHints();
     
     /**
-     * @brief 更新教学提示
+     * @brief 绘制目标、教学提示与临时消息（屏幕坐标）
+     * @param painter 画笔
      */
-    void updateTutorialHints();
+    void drawHud(QPainter& painter);
+    
+    /**
+     * @brief 设置界面文字，内容未变化时保留已排版的结果
+     * @param text 静态文字
+     * @param value 新内容
+     */
+    static void setHudText(QStaticText& text, const QString& value);
     
     /**
      * @brief 检查关卡完成条件
@@ -230,11 +247,62 @@ private:
     
     /**
      * @brief 绘制游戏元素
-     * @param painter 绘制器
+     * @param painter 绘制器（世界坐标）
+     * @param view 可见区域（世界坐标），只绘制与之相交的元素
      */
-    void drawGameElements(QPainter& painter);
+    void drawGameElements(QPainter& painter, const QRectF& view);
     
+    /**
+     * @brief 判断元素是否属于静态图层
+     * 
+     * 水、岩浆、出口和箭机关在关卡运行期间位置不变，随实心方块一起
+     * 预先合成到静态图层中，每帧只需一次贴图。
+     * 
+     * @param type 元素类型
+     * @return bool 是否绘制在静态图层中
+     */
+    static bool isStaticLayerElement(GameElementType type);
     
+    /**
+     * @brief 获取静态图层分块，不在缓存中时构建
+     * @param chunkX 分块列
+     * @param chunkY 分块行
+     * @return QPixmap* 分块图像（分块内无静态内容时为空图像），在下次构建分块前有效
+     */
+    QPixmap* staticChunk(int chunkX, int chunkY);
+    
+    /**
+     * @brief 绘制一个静态元素（水、岩浆、出口、箭机关）
+     * @param painter 绘制器（世界坐标）
+     * @param element 游戏元素
+     */
+    void drawStaticElement(QPainter& painter, const GameElement& element);
+    
+    /**
+     * @brief 标记静态图层全部失效，绘制时按需重建可见分块
+     * @note 在关卡加载或网格/出口状态变化时调用
+     */
+    void invalidateStaticLayer() {
+        static_chunks.clear();
+        static_layer_exit_unlocked = isExitUnlocked();
+    }
+    
+    /**
+     * @brief 关卡数据变化后重置静态图层与摄像机取景范围
+     */
+    void onLevelDataLoaded();
+    
+    /**
+     * @brief 检查青菜收集目标是否全部完成（决定出口是否可通关）
+     * @return bool 是否已完成
+     */
+    bool isExitUnlocked() const;
+    
+    /**
+     * @brief 获取插值后的玩家绘制位置
+     * @return QPointF 上一tick与当前tick之间按 render_alpha 插值的位置
+     */
+    QPointF interpolatedPlayerPos() const;
     
     /**
      * @brief 显示游戏提示信息
@@ -244,17 +312,11 @@ private:
     void showGameMessage(const QString& message, int duration = 3000);
     
     /**
-     * @brief 保存游戏进度
-     * @param levelIndex 当前关卡索引
+     * @brief 保存游戏进度（解锁并记录进入的关卡）
+     * @param levelIndex 当前关卡索引（从0开始）
      */
     void saveGameProgress(int levelIndex);
     
-    /**
-     * @brief 加载游戏进度
-     * @return QJsonObject 进度数据
-     */
-    QJsonObject loadGameProgress();
-    
     /**
      * @brief 检查关卡是否已解锁
      * @param levelIndex 关卡索引
@@ -294,51 +356,6 @@ private:
      * @brief 隐藏暂停菜单
      */
     void hidePauseMenu();
-    
-    // === 移动平台和开关门方法 ===
-    
-    /**
-     * @brief 初始化移动平台状态
-     */
-    void initializeMovingPlatforms();
-    
-    /**
-     * @brief 更新移动平台位置
-     */
-    void updateMovingPlatforms();
-    
-    /**
-     * @brief 初始化开关门状态
-     */
-    void initializeSwitchDoors();
-    
-    /**
-     * @brief 检查玩家与开关的碰撞
-     */
-    void checkSwitchCollisions();
-    
-    /**
-     * @brief 检查玩家与移动平台的碰撞
-     */
-    void checkMovingPlatformCollisions();
-    
-    /**
-     * @brief 处理玩家跟随移动平台
-     */
-    void handlePlatformFollowing();
-    
-    /**
-     * @brief 激活开关
-     * @param switch_index 开关索引
-     */
-    void activateSwitch(int switch_index);
-    
-    /**
-     * @brief 检查门的碰撞（关闭的门阻挡玩家）
-     * @param playerRect 玩家矩形
-     * @return bool 是否与关闭的门发生碰撞
-     */
-    bool checkDoorCollision(const QRectF& playerRect);
 };
 
 #endif
@@ -6,6 +6,7 @@
 #include <QLabel>
 #include <QPalette>
 #include <QPixmap>
+#include "TextureCache.h"
 #include <QFont>
 
 HelpPage::HelpPage(QWidget *parent)
@@ -27,7 +28,7 @@ void HelpPage::setupUI()
     resize(1280, 720);
     
     // 设置背景图片
-    QPixmap background(":/images/menu.jpg");
+    QPixmap background = TextureCache::getInstance().pixmap(":/images/menu.jpg");
     QPixmap scaledBackground = background.scaled(this->size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
     QPalette palette;
     palette.setBrush(QPalette::Window, scaledBackground);
@@ -7,12 +7,107 @@
 
 #include "LevelData.h"
 #include "Config.h"
+#include "LogCategories.h"
+#include <QFileInfo>
+#include <QDir>
+#include <QCryptographicHash>
+#include <QCborValue>
+#include <QCborMap>
+#include <QCborArray>
+#include <cmath>
+#include <cstring>
+
+// === 二进制关卡格式（.lvlb） ===
+// 小端序，所有段按8字节对齐，结构体与文件布局一一对应，加载时直接从内存映射读取：
+//   文件头 | 网格（逐行位图，每行 grid_row_words 个quint64，bit x 为第x列实心）
+//   | 元素表 | 目标表 | 字符串区（UTF-8字符串、CBOR编码的原始properties与逻辑节点定义）
+namespace {
+const quint32 LEVEL_BINARY_MAGIC = 0x424C4A4C;   // "LJLB"
+const quint16 LEVEL_BINARY_VERSION = 4;
+
+/// 字符串区中的一段数据
+struct BlobRef {
+    quint32 offset;
+    quint32 size;
+};
+
+struct LevelBinaryHeader {
+    quint32 magic;
+    quint16 version;
+    quint16 header_size;
+    qint32 width;
+    qint32 height;
+    double start_x;
+    double start_y;
+    quint8 source_hash[20];         ///< 源JSON文件SHA-1
+    quint32 grid_offset;
+    quint32 grid_row_words;
+    quint32 element_offset;
+    quint32 element_count;
+    quint32 objective_offset;
+    quint32 objective_count;
+    BlobRef name;
+    BlobRef description;
+    quint32 blob_offset;
+    quint32 blob_size;
+    BlobRef logic;                  ///< 逻辑节点定义，CBOR，为空时size为0
+    quint32 reserved;
+};
+
+struct LevelBinaryElement {
+    double x;
+    double y;
+    double width;
+    double height;
+    double end_x;                   ///< PlatformProps
+    double end_y;
+    double distance;
+    double speed;
+    qint32 type;
+    qint32 arrow_direction;         ///< ArrowTrapProps
+    qint32 fire_interval;
+    qint32 flags;                   ///< bit0: PairingProps::has_pair_id，bit1: PlatformProps::loop，bit2: TriggerProps::momentary
+    qint32 pair_id;
+    qint32 paired_door;
+    qint32 easing;                  ///< PlatformProps::easing
+    BlobRef texture;
+    BlobRef properties;             ///< CBOR，空对象时size为0
+    BlobRef via;                    ///< PlatformProps::via，依次存放x、y（double）
+    BlobRef trigger_name;           ///< TriggerProps::name
+    BlobRef trigger_input;          ///< TriggerProps::input
+    quint32 reserved;
+};
+
+struct LevelBinaryObjective {
+    BlobRef type;
+    BlobRef description;
+    qint32 target_count;
+    qint32 current_count;
+};
+
+static_assert(sizeof(LevelBinaryHeader) == 112, "二进制关卡文件头布局变化");
+static_assert(sizeof(LevelBinaryElement) == 136, "二进制关卡元素布局变化");
+static_assert(sizeof(LevelBinaryObjective) == 24, "二进制关卡目标布局变化");
+
+template <typename T>
+void appendRaw(QByteArray& out, const T& value)
+{
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void alignTo8(QByteArray& out)
+{
+    while (out.size() % 8 != 0) out.append('\0');
+}
+}
 
 LevelData::LevelData(int width, int height)
     : level_width(width)
     , level_height(height)
     , level_name("未命名关卡")
     , level_description("暂无描述")
+    , chunk_cols(0)
+    , chunk_rows(0)
     , player_start_position(X, Y)  // 使用Config.h中的默认值
     , is_custom_level(false)
     , file_path("")
@@ -22,14 +117,14 @@ LevelData::LevelData(int width, int height)
 
 void LevelData::initializeGrid()
 {
-    // 初始化网格为空
-    level_grid.resize(level_height);
-    for (int i = 0; i < level_height; ++i) {
-        level_grid[i].resize(level_width);
-        for (int j = 0; j < level_width; ++j) {
-            level_grid[i][j] = GameElementType::Empty;
-        }
-    }
+    // 初始化网格为空：按分块存储，分块在首次写入非空元素时才分配
+    level_width = qMax(1, level_width);
+    level_height = qMax(1, level_height);
+    chunk_cols = (level_width + CHUNK_TILES - 1) / CHUNK_TILES;
+    chunk_rows = (level_height + CHUNK_TILES - 1) / CHUNK_TILES;
+    tile_chunks.clear();
+    tile_chunks.resize(chunk_cols * chunk_rows);
+    collision_grid.resize(level_width, level_height);
 }
 
 bool LevelData::isValidCoordinate(int x, int y) const
@@ -42,21 +137,41 @@ GameElementType LevelData::getElementAt(int x, int y) const
     if (!isValidCoordinate(x, y)) {
         return GameElementType::Empty;
     }
-    return level_grid[y][x];
+    const TileChunk& chunk = tile_chunks[(y / CHUNK_TILES) * chunk_cols + x / CHUNK_TILES];
+    if (chunk.cells.isEmpty()) {
+        return GameElementType::Empty;
+    }
+    return static_cast<GameElementType>(chunk.cells[(y % CHUNK_TILES) * CHUNK_TILES + x % CHUNK_TILES]);
+}
+
+bool LevelData::isChunkEmpty(int chunkX, int chunkY) const
+{
+    if (chunkX < 0 || chunkX >= chunk_cols || chunkY < 0 || chunkY >= chunk_rows) {
+        return true;
+    }
+    return tile_chunks[chunkY * chunk_cols + chunkX].cells.isEmpty();
 }
 
 void LevelData::setElementAt(int x, int y, GameElementType type)
 {
     if (!isValidCoordinate(x, y)) {
-        qDebug() << "警告：尝试设置无效坐标的元素：" << x << "," << y;
+        qCDebug(lcLevel) << "警告：尝试设置无效坐标的元素：" << x << "," << y;
         return;
     }
-    level_grid[y][x] = type;
+    collision_grid.setSolid(x, y, type == GameElementType::SolidBlock);
+
+    TileChunk& chunk = tile_chunks[(y / CHUNK_TILES) * chunk_cols + x / CHUNK_TILES];
+    if (chunk.cells.isEmpty()) {
+        if (type == GameElementType::Empty) return;
+        chunk.cells.fill(static_cast<quint8>(GameElementType::Empty), CHUNK_TILES * CHUNK_TILES);
+    }
+    chunk.cells[(y % CHUNK_TILES) * CHUNK_TILES + x % CHUNK_TILES] = static_cast<quint8>(type);
 }
 
 void LevelData::addGameElement(const GameElement& element)
 {
     game_elements.append(element);
+    compileElementProperties(game_elements.last());
     
     // 同时更新网格数据
     int gridX = static_cast<int>(element.position.x() / B0);
@@ -64,6 +179,98 @@ void LevelData::addGameElement(const GameElement& element)
     setElementAt(gridX, gridY, element.element_type);
 }
 
+void LevelData::compileElementProperties(GameElement& element)
+{
+    const QJsonObject& props = element.properties;
+
+    switch (element.element_type) {
+    case GameElementType::ArrowTrap: {
+        const QString direction = props.value("direction").toString("right");
+        if (direction == "left") {
+            element.arrow.direction = ArrowDirection::Left;
+        } else if (direction == "up") {
+            element.arrow.direction = ArrowDirection::Up;
+        } else if (direction == "down") {
+            element.arrow.direction = ArrowDirection::Down;
+        } else {
+            element.arrow.direction = ArrowDirection::Right;
+        }
+        element.arrow.fire_interval = qMax(1, props.value("rate").toInt(60));
+        element.trigger.input = props.value("input").toString();
+        break;
+    }
+    case GameElementType::HorizontalPlatform:
+    case GameElementType::VerticalPlatform: {
+        // 多点路径：path 为起点之后依次经过的 [x, y] 点，最后一点为终点
+        element.platform.via.clear();
+        const QJsonArray path = props.value("path").toArray();
+        for (const QJsonValue& value : path) {
+            const QJsonArray point = value.toArray();
+            if (point.size() >= 2) {
+                element.platform.via.append(QPointF(point[0].toDouble(), point[1].toDouble()));
+            }
+        }
+        if (!element.platform.via.isEmpty()) {
+            element.platform.end_pos = element.platform.via.takeLast();
+        } else if (props.contains("end_x") && props.contains("end_y")) {
+            element.platform.end_pos = QPointF(props.value("end_x").toDouble(),
+                                               props.value("end_y").toDouble());
+        } else if (element.element_type == GameElementType::HorizontalPlatform) {
+            element.platform.end_pos = element.position + QPointF(B0 * 3, 0); // 向右移动3格
+        } else {
+            element.platform.end_pos = element.position + QPointF(0, B0 * 3); // 向下移动3格
+        }
+
+        double distance = 0.0;
+        QPointF from = element.position;
+        for (const QPointF& to : element.platform.via + QVector<QPointF>{element.platform.end_pos}) {
+            const QPointF delta = to - from;
+            distance += std::sqrt(delta.x() * delta.x() + delta.y() * delta.y());
+            from = to;
+        }
+        element.platform.distance = distance;
+        element.platform.speed = B0 / 60.0; // 每秒移动1格
+        element.platform.easing = props.value("easing").toString() == "sine"
+                                      ? PlatformEasing::Sine : PlatformEasing::Linear;
+        element.platform.loop = props.value("loop").toBool(false);
+        element.trigger.input = props.value("input").toString();
+        break;
+    }
+    case GameElementType::Switch:
+    case GameElementType::Door: {
+        const QJsonValue id = props.value(element.element_type == GameElementType::Switch
+                                          ? "switch_id" : "door_id");
+        const QString idText = id.toString();
+        element.pairing.has_pair_id = !idText.isEmpty();
+        if (element.pairing.has_pair_id) {
+            // 非负整数id原样使用，以便与缺省id（元素索引）比较；其余字符串映射为负数
+            bool isNumber = false;
+            const int value = idText.toInt(&isNumber);
+            if (isNumber && value >= 0 && QString::number(value) == idText) {
+                element.pairing.pair_id = value;
+            } else {
+                auto it = pair_id_table.constFind(idText);
+                if (it == pair_id_table.constEnd()) {
+                    it = pair_id_table.insert(idText, -1 - pair_id_table.size());
+                }
+                element.pairing.pair_id = it.value();
+            }
+        }
+        element.pairing.paired_door = props.contains("paired_door")
+                                      ? props.value("paired_door").toInt() : -1;
+        if (element.element_type == GameElementType::Switch) {
+            element.trigger.name = idText;
+            element.trigger.momentary = props.value("mode").toString() == "plate";
+        } else {
+            element.trigger.input = props.value("input").toString();
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
 void LevelData::addObjective(const LevelObjective& objective)
 {
     level_objectives.append(objective);
@@ -74,8 +281,8 @@ void LevelData::updateObjectiveProgress(const QString& objectiveType, int increm
     for (auto& objective : level_objectives) {
         if (objective.objective_type == objectiveType) {
             objective.current_count += increment;
-            qDebug() << "目标进度更新：" << objectiveType 
-                     << objective.current_count << "/" << objective.target_count;
+            LJ_HOT_DEBUG(lcObjective) << "目标进度更新：" << objectiveType
+                                      << objective.current_count << "/" << objective.target_count;
             break;
         }
     }
@@ -101,23 +308,46 @@ void LevelData::resetObjectiveProgress()
 {
     for (auto& objective : level_objectives) {
         objective.current_count = 0;
-        qDebug() << "重置目标进度：" << objective.objective_type;
+        LJ_HOT_DEBUG(lcObjective) << "重置目标进度：" << objective.objective_type;
     }
 }
 
 bool LevelData::loadFromFile(const QString& filePath)
 {
+    // 直接指定编译文件时不做哈希校验
+    if (filePath.endsWith(".lvlb", Qt::CaseInsensitive)) {
+        if (!loadFromBinary(filePath)) {
+            return false;
+        }
+        setCustomLevel(true, filePath);
+        return true;
+    }
+
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly)) {
-        qDebug() << "无法打开关卡文件：" << filePath;
+        qCDebug(lcLevel) << "无法打开关卡文件：" << filePath;
         return false;
     }
     
     QByteArray data = file.readAll();
+
+    // JSON仍是编辑格式：同目录下存在与其内容哈希一致的编译文件时优先加载编译文件
+    const QByteArray sourceHash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    const QString compiledPath = compiledPathFor(filePath);
+    if (QFileInfo::exists(compiledPath) && loadFromBinary(compiledPath, sourceHash)) {
+        setCustomLevel(true, filePath);
+        return true;
+    }
+
+    return loadFromJsonData(data, filePath);
+}
+
+bool LevelData::loadFromJsonData(const QByteArray& data, const QString& filePath)
+{
     QJsonDocument doc = QJsonDocument::fromJson(data);
     
     if (doc.isNull() || !doc.isObject()) {
-        qDebug() << "关卡文件格式错误：" << filePath;
+        qCDebug(lcLevel) << "关卡文件格式错误：" << filePath;
         return false;
     }
     
@@ -129,7 +359,7 @@ bool LevelData::saveToFile(const QString& filePath) const
 {
     QFile file(filePath);
     if (!file.open(QIODevice::WriteOnly)) {
-        qDebug() << "无法创建关卡文件：" << filePath;
+        qCDebug(lcLevel) << "无法创建关卡文件：" << filePath;
         return false;
     }
     
@@ -138,6 +368,291 @@ bool LevelData::saveToFile(const QString& filePath) const
     return true;
 }
 
+QString LevelData::compiledPathFor(const QString& jsonPath)
+{
+    const QFileInfo info(jsonPath);
+    return info.dir().absoluteFilePath(info.completeBaseName() + ".lvlb");
+}
+
+bool LevelData::compileFile(const QString& jsonPath, const QString& outPath)
+{
+    QFile file(jsonPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCDebug(lcLevel) << "无法打开关卡文件：" << jsonPath;
+        return false;
+    }
+    const QByteArray data = file.readAll();
+
+    // 始终从JSON编译，不使用已有的编译文件
+    LevelData level;
+    if (!level.loadFromJsonData(data, jsonPath)) {
+        return false;
+    }
+    return level.saveToBinary(outPath.isEmpty() ? compiledPathFor(jsonPath) : outPath,
+                              QCryptographicHash::hash(data, QCryptographicHash::Sha1));
+}
+
+bool LevelData::saveToBinary(const QString& filePath, const QByteArray& sourceHash) const
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    qCDebug(lcLevel) << "二进制关卡格式仅支持小端序平台：" << filePath;
+    return false;
+#endif
+    QByteArray blob;
+    auto addBlob = [&blob](const QByteArray& bytes) {
+        BlobRef ref{quint32(blob.size()), quint32(bytes.size())};
+        blob.append(bytes);
+        return ref;
+    };
+
+    LevelBinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.magic = LEVEL_BINARY_MAGIC;
+    header.version = LEVEL_BINARY_VERSION;
+    header.header_size = sizeof(LevelBinaryHeader);
+    header.width = level_width;
+    header.height = level_height;
+    header.start_x = player_start_position.x();
+    header.start_y = player_start_position.y();
+    std::memcpy(header.source_hash, sourceHash.constData(), qMin<int>(sourceHash.size(), sizeof(header.source_hash)));
+    header.name = addBlob(level_name.toUtf8());
+    header.description = addBlob(level_description.toUtf8());
+    header.logic = addBlob(logic_nodes.isEmpty()
+                           ? QByteArray()
+                           : QCborValue::fromJsonValue(logic_nodes).toCbor());
+
+    QByteArray out;
+    out.append(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // 网格：只记录实心方块，其余格子由元素表恢复
+    alignTo8(out);
+    header.grid_offset = out.size();
+    header.grid_row_words = (level_width + 63) / 64;
+    for (int y = 0; y < level_height; ++y) {
+        for (quint32 w = 0; w < header.grid_row_words; ++w) {
+            quint64 word = 0;
+            for (int bit = 0; bit < 64; ++bit) {
+                const int x = int(w) * 64 + bit;
+                if (x < level_width && getElementAt(x, y) == GameElementType::SolidBlock) {
+                    word |= quint64(1) << bit;
+                }
+            }
+            appendRaw(out, word);
+        }
+    }
+
+    // 元素表：保存预解析的类型化属性，加载时无需再解析properties
+    alignTo8(out);
+    header.element_offset = out.size();
+    header.element_count = game_elements.size();
+    for (const GameElement& element : game_elements) {
+        LevelBinaryElement rec;
+        std::memset(&rec, 0, sizeof(rec));
+        rec.x = element.position.x();
+        rec.y = element.position.y();
+        rec.width = element.size.x();
+        rec.height = element.size.y();
+        rec.end_x = element.platform.end_pos.x();
+        rec.end_y = element.platform.end_pos.y();
+        rec.distance = element.platform.distance;
+        rec.speed = element.platform.speed;
+        rec.type = static_cast<qint32>(element.element_type);
+        rec.arrow_direction = static_cast<qint32>(element.arrow.direction);
+        rec.fire_interval = element.arrow.fire_interval;
+        rec.easing = static_cast<qint32>(element.platform.easing);
+        rec.flags = (element.pairing.has_pair_id ? 1 : 0) | (element.platform.loop ? 2 : 0) |
+                    (element.trigger.momentary ? 4 : 0);
+        rec.pair_id = element.pairing.pair_id;
+        rec.paired_door = element.pairing.paired_door;
+        rec.texture = addBlob(element.texture_path.toUtf8());
+        rec.trigger_name = addBlob(element.trigger.name.toUtf8());
+        rec.trigger_input = addBlob(element.trigger.input.toUtf8());
+        if (!element.platform.via.isEmpty()) {
+            QByteArray via;
+            for (const QPointF& point : element.platform.via) {
+                const double xy[2] = {point.x(), point.y()};
+                via.append(reinterpret_cast<const char*>(xy), sizeof(xy));
+            }
+            rec.via = addBlob(via);
+        }
+        // 原始properties只供编辑器使用，按CBOR保留
+        rec.properties = addBlob(element.properties.isEmpty()
+                                 ? QByteArray()
+                                 : QCborValue::fromJsonValue(element.properties).toCbor());
+        appendRaw(out, rec);
+    }
+
+    alignTo8(out);
+    header.objective_offset = out.size();
+    header.objective_count = level_objectives.size();
+    for (const LevelObjective& objective : level_objectives) {
+        LevelBinaryObjective rec;
+        rec.type = addBlob(objective.objective_type.toUtf8());
+        rec.description = addBlob(objective.description.toUtf8());
+        rec.target_count = objective.target_count;
+        rec.current_count = objective.current_count;
+        appendRaw(out, rec);
+    }
+
+    alignTo8(out);
+    header.blob_offset = out.size();
+    header.blob_size = blob.size();
+    out.append(blob);
+    std::memcpy(out.data(), &header, sizeof(header));
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(lcLevel) << "无法创建关卡文件：" << filePath;
+        return false;
+    }
+    return file.write(out) == out.size();
+}
+
+bool LevelData::loadFromBinary(const QString& filePath, const QByteArray& sourceHash)
+{
+#if Q_BYTE_ORDER == Q_BIG_ENDIAN
+    return false;
+#endif
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const qint64 fileSize = file.size();
+    if (fileSize < qint64(sizeof(LevelBinaryHeader))) {
+        qCDebug(lcLevel) << "二进制关卡文件已损坏：" << filePath;
+        return false;
+    }
+    const uchar* base = file.map(0, fileSize);
+    if (!base) {
+        qCDebug(lcLevel) << "无法映射关卡文件：" << filePath;
+        return false;
+    }
+
+    // 段越界检查，映射区域在 file 析构时释放
+    auto inFile = [fileSize](quint64 offset, quint64 size) {
+        return offset + size <= quint64(fileSize);
+    };
+
+    const LevelBinaryHeader& header = *reinterpret_cast<const LevelBinaryHeader*>(base);
+    if (header.magic != LEVEL_BINARY_MAGIC || header.version != LEVEL_BINARY_VERSION ||
+        header.header_size != sizeof(LevelBinaryHeader)) {
+        qCDebug(lcLevel) << "二进制关卡文件格式错误：" << filePath;
+        return false;
+    }
+    if (!sourceHash.isEmpty() &&
+        (sourceHash.size() != int(sizeof(header.source_hash)) ||
+         std::memcmp(header.source_hash, sourceHash.constData(), sizeof(header.source_hash)) != 0)) {
+        return false;   // 源JSON已修改，编译文件过期
+    }
+    if (header.width <= 0 || header.height <= 0 ||
+        header.grid_row_words != quint32((header.width + 63) / 64) ||
+        !inFile(header.grid_offset, quint64(header.grid_row_words) * header.height * sizeof(quint64)) ||
+        !inFile(header.element_offset, quint64(header.element_count) * sizeof(LevelBinaryElement)) ||
+        !inFile(header.objective_offset, quint64(header.objective_count) * sizeof(LevelBinaryObjective)) ||
+        !inFile(header.blob_offset, header.blob_size) ||
+        header.grid_offset % 8 != 0 || header.element_offset % 8 != 0 || header.objective_offset % 8 != 0) {
+        qCDebug(lcLevel) << "二进制关卡文件已损坏：" << filePath;
+        return false;
+    }
+
+    const char* blob = reinterpret_cast<const char*>(base + header.blob_offset);
+    const auto* elements = reinterpret_cast<const LevelBinaryElement*>(base + header.element_offset);
+    const auto* objectives = reinterpret_cast<const LevelBinaryObjective*>(base + header.objective_offset);
+    auto blobValid = [&header](const BlobRef& ref) {
+        return quint64(ref.offset) + ref.size <= header.blob_size;
+    };
+    bool blobsValid = blobValid(header.name) && blobValid(header.description) && blobValid(header.logic);
+    for (quint32 i = 0; i < header.element_count; ++i) {
+        blobsValid = blobsValid && blobValid(elements[i].texture) && blobValid(elements[i].properties) &&
+                     blobValid(elements[i].via) && elements[i].via.size % (2 * sizeof(double)) == 0 &&
+                     blobValid(elements[i].trigger_name) && blobValid(elements[i].trigger_input);
+    }
+    for (quint32 i = 0; i < header.objective_count; ++i) {
+        blobsValid = blobsValid && blobValid(objectives[i].type) && blobValid(objectives[i].description);
+    }
+    if (!blobsValid) {
+        qCDebug(lcLevel) << "二进制关卡文件已损坏：" << filePath;
+        return false;
+    }
+    auto blobString = [blob](const BlobRef& ref) {
+        return QString::fromUtf8(blob + ref.offset, int(ref.size));
+    };
+
+    // 校验通过后才修改当前数据
+    level_name = blobString(header.name);
+    level_description = blobString(header.description);
+    level_width = header.width;
+    level_height = header.height;
+    initializeGrid();
+    player_start_position = QPointF(header.start_x, header.start_y);
+
+    const quint64* grid = reinterpret_cast<const quint64*>(base + header.grid_offset);
+    for (int y = 0; y < level_height; ++y) {
+        const quint64* row = grid + quint64(y) * header.grid_row_words;
+        for (quint32 w = 0; w < header.grid_row_words; ++w) {
+            quint64 bits = row[w];
+            while (bits) {
+                setElementAt(int(w) * 64 + qCountTrailingZeroBits(bits), y, GameElementType::SolidBlock);
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // 元素按原顺序加入（与JSON加载一样依次覆盖网格），类型化属性直接取自文件
+    game_elements.clear();
+    game_elements.reserve(header.element_count);
+    for (quint32 i = 0; i < header.element_count; ++i) {
+        const LevelBinaryElement& rec = elements[i];
+        GameElement element(static_cast<GameElementType>(rec.type), QPointF(rec.x, rec.y),
+                            QPointF(rec.width, rec.height));
+        element.texture_path = blobString(rec.texture);
+        if (rec.properties.size > 0) {
+            const QByteArray cbor = QByteArray::fromRawData(blob + rec.properties.offset, int(rec.properties.size));
+            element.properties = QCborValue::fromCbor(cbor).toMap().toJsonObject();
+        }
+        element.arrow.direction = static_cast<ArrowDirection>(qBound(0, rec.arrow_direction, 3));
+        element.arrow.fire_interval = qMax(1, rec.fire_interval);
+        element.platform.end_pos = QPointF(rec.end_x, rec.end_y);
+        element.platform.distance = rec.distance;
+        element.platform.speed = rec.speed;
+        element.platform.easing = rec.easing == int(PlatformEasing::Sine) ? PlatformEasing::Sine : PlatformEasing::Linear;
+        element.platform.loop = (rec.flags & 2) != 0;
+        for (quint32 offset = 0; offset < rec.via.size; offset += 2 * sizeof(double)) {
+            double xy[2];
+            std::memcpy(xy, blob + rec.via.offset + offset, sizeof(xy));   // 字符串区不保证对齐
+            element.platform.via.append(QPointF(xy[0], xy[1]));
+        }
+        element.pairing.has_pair_id = (rec.flags & 1) != 0;
+        element.pairing.pair_id = rec.pair_id;
+        element.pairing.paired_door = rec.paired_door;
+        element.trigger.name = blobString(rec.trigger_name);
+        element.trigger.input = blobString(rec.trigger_input);
+        element.trigger.momentary = (rec.flags & 4) != 0;
+
+        game_elements.append(element);
+        setElementAt(static_cast<int>(element.position.x() / B0),
+                     static_cast<int>(element.position.y() / B0), element.element_type);
+    }
+
+    logic_nodes = QJsonArray();
+    if (header.logic.size > 0) {
+        const QByteArray cbor = QByteArray::fromRawData(blob + header.logic.offset, int(header.logic.size));
+        logic_nodes = QCborValue::fromCbor(cbor).toArray().toJsonArray();
+    }
+
+    level_objectives.clear();
+    level_objectives.reserve(header.objective_count);
+    for (quint32 i = 0; i < header.objective_count; ++i) {
+        LevelObjective objective;
+        objective.objective_type = blobString(objectives[i].type);
+        objective.description = blobString(objectives[i].description);
+        objective.target_count = objectives[i].target_count;
+        objective.current_count = objectives[i].current_count;
+        level_objectives.append(objective);
+    }
+    return true;
+}
+
 bool LevelData::loadFromJson(const QJsonObject& jsonObj)
 {
     // 加载基本信息
@@ -215,6 +730,9 @@ bool LevelData::loadFromJson(const QJsonObject& jsonObj)
         
         addObjective(objective);
     }
+
+    // 逻辑节点定义原样保存，编译在模拟世界加载关卡时进行
+    logic_nodes = jsonObj["logic"].toArray();
     
     // 自动生成目标：如果关卡没有设置目标但包含青菜，自动创建青菜收集目标
     if (level_objectives.isEmpty()) {
@@ -233,7 +751,7 @@ bool LevelData::loadFromJson(const QJsonObject& jsonObj)
             vegetableObjective.description = QString("收集所有青菜 (%1/%2)").arg(0).arg(vegetableCount);
             
             addObjective(vegetableObjective);
-            qDebug() << "自动为关卡生成青菜收集目标，数量：" << vegetableCount;
+            qCDebug(lcLevel) << "自动为关卡生成青菜收集目标，数量：" << vegetableCount;
         }
     }
     
@@ -261,7 +779,7 @@ QJsonObject LevelData::toJson() const
     for (int y = 0; y < level_height; ++y) {
         QJsonArray row;
         for (int x = 0; x < level_width; ++x) {
-            int v = (level_grid[y][x] == GameElementType::SolidBlock) ? 1 : 0;
+            int v = (getElementAt(x, y) == GameElementType::SolidBlock) ? 1 : 0;
             row.append(v);
         }
         gridArray.append(row);
@@ -296,6 +814,10 @@ QJsonObject LevelData::toJson() const
         objectivesArray.append(objObj);
     }
     jsonObj["objectives"] = objectivesArray;
+
+    if (!logic_nodes.isEmpty()) {
+        jsonObj["logic"] = logic_nodes;
+    }
     
     return jsonObj;
 }
@@ -309,10 +831,10 @@ void LevelData::getLegacyMapArray(int mapArray[24][24]) const
         }
     }
     
-    // 填充数据（注意坐标转换：level_grid[y][x] -> mapArray[x][y]）
+    // 填充数据（注意坐标转换：网格(x, y) -> mapArray[x][y]）
     for (int y = 0; y < qMin(level_height, 24); ++y) {
         for (int x = 0; x < qMin(level_width, 24); ++x) {
-            GameElementType type = level_grid[y][x];
+            GameElementType type = getElementAt(x, y);
             if (type == GameElementType::SolidBlock) {
                 mapArray[x][y] = 1;
             } else {
@@ -327,15 +849,12 @@ void LevelData::setFromLegacyMapArray(const int mapArray[24][24])
     // 清空现有数据
     initializeGrid();
     
-    // 从数组填充数据（注意坐标转换：mapArray[x][y] -> level_grid[y][x]）
+    // 从数组填充数据（注意坐标转换：mapArray[x][y] -> 网格(x, y)）
     for (int x = 0; x < 24; ++x) {
         for (int y = 0; y < 24; ++y) {
             if (x < level_width && y < level_height) {
-                if (mapArray[x][y] == 1) {
-                    level_grid[y][x] = GameElementType::SolidBlock;
-                } else {
-                    level_grid[y][x] = GameElementType::Empty;
-                }
+                setElementAt(x, y, mapArray[x][y] == 1 ? GameElementType::SolidBlock
+                                                       : GameElementType::Empty);
             }
         }
     }
@@ -343,11 +862,11 @@ void LevelData::setFromLegacyMapArray(const int mapArray[24][24])
 
 void LevelData::getMapArray(int** mapArray, int width, int height) const
 {
-    // 填充数据（注意坐标转换：level_grid[y][x] -> mapArray[x][y]）
+    // 填充数据（注意坐标转换：网格(x, y) -> mapArray[x][y]）
     for (int x = 0; x < width; ++x) {
         for (int y = 0; y < height; ++y) {
             if (x < level_width && y < level_height) {
-                GameElementType type = level_grid[y][x];
+                GameElementType type = getElementAt(x, y);
                 if (type == GameElementType::SolidBlock) {
                     mapArray[x][y] = 1;
                 } else {
@@ -363,11 +882,11 @@ void LevelData::getMapArray(int** mapArray, int width, int height) const
 void LevelData::removeElementsAt(int grid_x, int grid_y)
 {
     if (!isValidCoordinate(grid_x, grid_y)) {
-        qDebug() << "警告：尝试删除无效坐标的元素：" << grid_x << "," << grid_y;
+        qCDebug(lcLevel) << "警告：尝试删除无效坐标的元素：" << grid_x << "," << grid_y;
         return;
     }
     // 清空网格对应类型
-    level_grid[grid_y][grid_x] = GameElementType::Empty;
+    setElementAt(grid_x, grid_y, GameElementType::Empty);
     // 过滤掉位于该格子的所有元素
     QVector<GameElement> remaining;
     remaining.reserve(game_elements.size());
@@ -10,6 +10,7 @@
 #define LEVELDATA_H
 
 #include <QVector>
+#include <QHash>
 #include <QPointF>
 #include <QString>
 #include <QJsonObject>
@@ -18,6 +19,7 @@
 #include <QFile>
 #include <QDebug>
 #include "Config.h"
+#include "CollisionGrid.h"
 
 /**
  * @enum GameElementType
@@ -52,6 +54,57 @@ enum class ArrowDirection {
     Down = 3    ///< 向下
 };
 
+/**
+ * @struct ArrowTrapProps
+ * @brief 箭机关的预解析属性
+ */
+struct ArrowTrapProps {
+    ArrowDirection direction = ArrowDirection::Right;  ///< 发射方向（properties.direction）
+    int fire_interval = 60;                            ///< 发射间隔tick（properties.rate）
+};
+
+/**
+ * @enum PlatformEasing
+ * @brief 移动平台沿路径的速度曲线
+ */
+enum class PlatformEasing {
+    Linear = 0, ///< 匀速
+    Sine = 1    ///< 正弦缓动：在路径两端减速、中段最快
+};
+
+/**
+ * @struct PlatformProps
+ * @brief 移动平台的预解析属性
+ */
+struct PlatformProps {
+    QPointF end_pos;            ///< 终点位置（properties.end_x/end_y或path的最后一点，缺省为水平向右/垂直向下3格）
+    QVector<QPointF> via;       ///< 起点与终点之间依次经过的路径点（properties.path除最后一点）
+    double distance = 0.0;      ///< 沿路径从起点到终点的长度（像素）
+    double speed = B0 / 60.0;   ///< 移动速度（像素/tick）
+    PlatformEasing easing = PlatformEasing::Linear;    ///< 速度曲线（properties.easing）
+    bool loop = false;          ///< 到达终点后直接回到起点循环，否则原路往返（properties.loop）
+};
+
+/**
+ * @struct PairingProps
+ * @brief 开关/门的预解析配对属性
+ */
+struct PairingProps {
+    bool has_pair_id = false;   ///< 是否显式指定了配对id（switch_id/door_id）
+    int pair_id = 0;            ///< 配对id（非负整数原样保留，其他字符串映射为负数）
+    int paired_door = -1;       ///< 开关直接指定的门元素索引（properties.paired_door，-1为无）
+};
+
+/**
+ * @struct TriggerProps
+ * @brief 触发图相关的预解析属性
+ */
+struct TriggerProps {
+    QString name;               ///< 开关在触发图中的名字（properties.switch_id，空为无）
+    QString input;              ///< 门/移动平台/箭机关的驱动节点名（properties.input，空为不接入或沿用配对）
+    bool momentary = false;     ///< 开关为压力板，玩家离开后复位（properties.mode为"plate"）
+};
+
 /**
  * @struct GameElement
  * @brief 游戏元素结构体
@@ -62,6 +115,12 @@ struct GameElement {
     QPointF size;                  ///< 元素大小
     QString texture_path;          ///< 纹理路径
     QJsonObject properties;        ///< 额外属性（如移动速度、伤害值等）
+
+    // 由properties预解析的类型化属性，只有对应类型的元素才有意义
+    ArrowTrapProps arrow;          ///< 箭机关属性
+    PlatformProps platform;        ///< 移动平台属性
+    PairingProps pairing;          ///< 开关/门配对属性
+    TriggerProps trigger;          ///< 触发图属性
     
     /**
      * @brief 默认构造函数
@@ -169,6 +228,23 @@ public:
      * @return GameElementType 元素类型
      */
     GameElementType getElementAt(int x, int y) const;
+
+    /**
+     * @brief 检查网格分块是否全空（未分配存储）
+     * @param chunkX 分块列
+     * @param chunkY 分块行
+     * @return bool 是否全空，越界返回true
+     */
+    bool isChunkEmpty(int chunkX, int chunkY) const;
+
+    int getChunkColumns() const { return chunk_cols; }
+    int getChunkRows() const { return chunk_rows; }
+
+    /**
+     * @brief 获取实心方块碰撞网格（随网格数据同步更新）
+     * @return const CollisionGrid& 碰撞网格
+     */
+    const CollisionGrid& getCollisionGrid() const { return collision_grid; }
     
     /**
      * @brief 设置指定位置的元素类型
@@ -179,7 +255,7 @@ public:
     void setElementAt(int x, int y, GameElementType type);
     
     /**
-     * @brief 添加游戏元素
+     * @brief 添加游戏元素（同时把properties预解析为类型化属性）
      * @param element 游戏元素
      */
     void addGameElement(const GameElement& element);
@@ -229,6 +305,20 @@ public:
      * @brief 重置所有目标的进度
      */
     void resetObjectiveProgress();
+
+    // === 触发逻辑 ===
+
+    /**
+     * @brief 获取逻辑节点定义（JSON顶层 logic 数组，原样保存，由模拟世界编译为触发图）
+     * @return const QJsonArray& 节点定义
+     */
+    const QJsonArray& getLogicNodes() const { return logic_nodes; }
+
+    /**
+     * @brief 设置逻辑节点定义
+     * @param nodes 节点定义
+     */
+    void setLogicNodes(const QJsonArray& nodes) { logic_nodes = nodes; }
     
     // === 玩家起始位置 ===
     
@@ -259,6 +349,37 @@ public:
      * @return bool 是否保存成功
      */
     bool saveToFile(const QString& filePath) const;
+
+    /**
+     * @brief 从编译后的二进制关卡文件（.lvlb）加载（内存映射，直接读取文件中的结构）
+     * @param filePath 文件路径
+     * @param sourceHash 期望的源JSON文件SHA-1，为空时不校验
+     * @return bool 是否加载成功（文件缺失、损坏或哈希不一致时返回false且不修改当前数据）
+     */
+    bool loadFromBinary(const QString& filePath, const QByteArray& sourceHash = QByteArray());
+
+    /**
+     * @brief 保存为二进制关卡文件（.lvlb）
+     * @param filePath 文件路径
+     * @param sourceHash 源JSON文件的SHA-1（加载时据此判断是否过期）
+     * @return bool 是否保存成功
+     */
+    bool saveToBinary(const QString& filePath, const QByteArray& sourceHash) const;
+
+    /**
+     * @brief 把JSON关卡文件编译为二进制关卡文件
+     * @param jsonPath JSON关卡文件路径
+     * @param outPath 输出路径，为空时使用 compiledPathFor(jsonPath)
+     * @return bool 是否编译成功
+     */
+    static bool compileFile(const QString& jsonPath, const QString& outPath = QString());
+
+    /**
+     * @brief JSON关卡文件对应的编译文件路径（同目录、扩展名改为.lvlb）
+     * @param jsonPath JSON关卡文件路径
+     * @return QString 编译文件路径
+     */
+    static QString compiledPathFor(const QString& jsonPath);
     
     /**
      * @brief 从JSON对象加载数据
@@ -301,9 +422,21 @@ private:
     QString level_name;                     ///< 关卡名称
     QString level_description;              ///< 关卡描述
     
-    QVector<QVector<GameElementType>> level_grid;  ///< 关卡网格数据
+    /**
+     * @struct TileChunk
+     * @brief CHUNK_TILES×CHUNK_TILES 的网格分块（行优先），全空的分块不分配存储
+     */
+    struct TileChunk {
+        QVector<quint8> cells;  ///< 元素类型，空分块时为空数组
+    };
+
+    QVector<TileChunk> tile_chunks;                ///< 关卡网格数据（按分块行优先）
+    int chunk_cols;                                ///< 水平分块数
+    int chunk_rows;                                ///< 垂直分块数
+    CollisionGrid collision_grid;                  ///< 实心方块碰撞网格（由网格数据派生）
     QVector<GameElement> game_elements;            ///< 游戏元素列表
     QVector<LevelObjective> level_objectives;      ///< 关卡目标列表
+    QJsonArray logic_nodes;                        ///< 逻辑节点定义（开关与门/平台/机关之间的门电路）
     
     QPointF player_start_position;          ///< 玩家起始位置
 
@@ -322,6 +455,22 @@ private:
      * @return bool 是否有效
      */
     bool isValidCoordinate(int x, int y) const;
+
+    /**
+     * @brief 按JSON格式解析关卡内容
+     * @param data 文件内容
+     * @param filePath 文件路径（用于错误信息）
+     * @return bool 是否加载成功
+     */
+    bool loadFromJsonData(const QByteArray& data, const QString& filePath);
+
+    /**
+     * @brief 把元素的properties解析为类型化属性，运行时不再读取JSON
+     * @param element 游戏元素
+     */
+    void compileElementProperties(GameElement& element);
+
+    QHash<QString, int> pair_id_table;      ///< 非数字配对id -> 映射后的负数id
 };
 
 #endif // LEVELDATA_H
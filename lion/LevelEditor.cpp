@@ -30,6 +30,11 @@ LevelEditorCanvas::LevelEditorCanvas(QWidget* parent)
 void LevelEditorCanvas::setLevelData(LevelData* levelData)
 {
     level_data = levelData;
+
+    // 画布尺寸跟随关卡尺寸，超出一屏的关卡通过滚动区域浏览
+    canvas_width = (level_data ? level_data->getWidth() : GRID_WIDTH) * grid_size;
+    canvas_height = (level_data ? level_data->getHeight() : GRID_HEIGHT) * grid_size;
+    setFixedSize(canvas_width, canvas_height);
     update();
 }
 
@@ -56,8 +61,8 @@ void LevelEditorCanvas::clearCanvas()
     }
     
     // 清空网格数据
-    for (int x = 0; x < GRID_WIDTH; ++x) {
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
+    for (int x = 0; x < level_data->getWidth(); ++x) {
+        for (int y = 0; y < level_data->getHeight(); ++y) {
             level_data->setElementAt(x, y, GameElementType::Empty);
         }
     }
@@ -91,8 +96,8 @@ QPoint LevelEditorCanvas::gridToScreen(const QPoint& gridPos) const
 
 void LevelEditorCanvas::placeElement(const QPoint& gridPos)
 {
-    if (!level_data || gridPos.x() < 0 || gridPos.x() >= GRID_WIDTH ||
-        gridPos.y() < 0 || gridPos.y() >= GRID_HEIGHT) {
+    if (!level_data || gridPos.x() < 0 || gridPos.x() >= level_data->getWidth() ||
+        gridPos.y() < 0 || gridPos.y() >= level_data->getHeight()) {
         return;
     }
     
@@ -172,40 +177,54 @@ void LevelEditorCanvas::paintEvent(QPaintEvent* event)
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
     
+    // 只重绘需要更新的区域（滚动区域中可见的部分）
+    const QRect area = event->rect();
+    
     // 绘制背景
-    painter.fillRect(rect(), QColor(173, 216, 230)); // 浅蓝色背景
+    painter.fillRect(area, QColor(173, 216, 230)); // 浅蓝色背景
     
     // 绘制网格
     if (show_grid) {
-        drawGrid(painter);
+        drawGrid(painter, area);
     }
     
     // 绘制关卡元素
-    drawLevelElements(painter);
+    drawLevelElements(painter, area);
 }
 
-void LevelEditorCanvas::drawGrid(QPainter& painter)
+void LevelEditorCanvas::drawGrid(QPainter& painter, const QRect& area)
 {
     painter.setPen(QPen(QColor(200, 200, 200), 1));
     
+    const int firstX = area.left() / grid_size * grid_size;
+    const int firstY = area.top() / grid_size * grid_size;
+    const int lastX = qMin(area.right() + 1, canvas_width);
+    const int lastY = qMin(area.bottom() + 1, canvas_height);
+    
     // 绘制垂直线
-    for (int x = 0; x <= canvas_width; x += grid_size) {
-        painter.drawLine(x, 0, x, canvas_height);
+    for (int x = firstX; x <= lastX; x += grid_size) {
+        painter.drawLine(x, area.top(), x, lastY);
     }
     
     // 绘制水平线
-    for (int y = 0; y <= canvas_height; y += grid_size) {
-        painter.drawLine(0, y, canvas_width, y);
+    for (int y = firstY; y <= lastY; y += grid_size) {
+        painter.drawLine(area.left(), y, lastX, y);
     }
 }
 
-void LevelEditorCanvas::drawLevelElements(QPainter& painter)
+void LevelEditorCanvas::drawLevelElements(QPainter& painter, const QRect& area)
 {
     if (!level_data) return;
     
+    // 只遍历重绘区域覆盖的格子
+    const int firstCol = qMax(0, area.left() / grid_size);
+    const int firstRow = qMax(0, area.top() / grid_size);
+    const int lastCol = qMin(level_data->getWidth() - 1, area.right() / grid_size);
+    const int lastRow = qMin(level_data->getHeight() - 1, area.bottom() / grid_size);
+    
     // 绘制网格元素
-    for (int x = 0; x < GRID_WIDTH; ++x) {
-        for (int y = 0; y < GRID_HEIGHT; ++y) {
+    for (int x = firstCol; x <= lastCol; ++x) {
+        for (int y = firstRow; y <= lastRow; ++y) {
             GameElementType elementType = level_data->getElementAt(x, y);
             if (elementType != GameElementType::Empty) {
                 QColor color = getElementColor(elementType);
@@ -217,6 +236,10 @@ void LevelEditorCanvas::drawLevelElements(QPainter& painter)
     // 绘制特殊元素
     const auto& elements = level_data->getGameElements();
     for (const auto& element : elements) {
+        if (!area.intersects(QRect(static_cast<int>(element.position.x()), static_cast<int>(element.position.y()),
+                                   static_cast<int>(element.size.x()), static_cast<int>(element.size.y())))) {
+            continue;
+        }
         QColor color = getElementColor(element.element_type);
         painter.fillRect(
             static_cast<int>(element.position.x()),
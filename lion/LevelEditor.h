@@ -165,14 +165,16 @@ private:
     /**
      * @brief 绘制网格
      * @param painter 绘制器
+     * @param area 需要重绘的区域
      */
-    void drawGrid(QPainter& painter);
+    void drawGrid(QPainter& painter, const QRect& area);
     
     /**
      * @brief 绘制关卡元素
      * @param painter 绘制器
+     * @param area 需要重绘的区域（大关卡只绘制滚动区域中可见的部分）
      */
-    void drawLevelElements(QPainter& painter);
+    void drawLevelElements(QPainter& painter, const QRect& area);
     
     /**
      * @brief 获取元素颜色
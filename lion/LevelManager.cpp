@@ -7,11 +7,21 @@
 
 #include "LevelManager.h"
 #include "Config.h"
+#include "ProgressStore.h"
+#include "LogCategories.h"
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDebug>
 #include <QApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QCryptographicHash>
+
+namespace {
+const quint32 CATALOG_MAGIC = 0x4C4A4349;   // "LJCI"
+const quint16 CATALOG_VERSION = 1;
+}
 
 LevelManager& LevelManager::getInstance()
 {
@@ -26,35 +36,30 @@ LevelManager::LevelManager(QObject* parent)
     // 设置关卡文件目录 - 使用智能路径检测
     QString dataDir = getDataDirectory();
     levels_directory = dataDir + "/levels";
-    progress_file_path = dataDir + "/progress.json";
-    qDebug() << "关卡目录路径:" << levels_directory;
+    catalog_index_path = levels_directory + "/catalog.idx";
+    qCDebug(lcLevel) << "关卡目录路径:" << levels_directory;
 }
 
 bool LevelManager::initialize()
 {
-    qDebug() << "初始化关卡管理器...";
+    qCDebug(lcLevel) << "初始化关卡管理器...";
     
     // 初始化目录结构
     if (!initializeDirectories()) {
-        qDebug() << "初始化目录失败";
+        qCDebug(lcLevel) << "初始化目录失败";
         return false;
     }
     
     // 尝试加载现有关卡
     if (!loadAllLevels()) {
-        qDebug() << "加载关卡失败，创建默认关卡";
+        qCDebug(lcLevel) << "加载关卡失败，创建默认关卡";
         createDefaultLevels();
     }
     
     // 加载游戏进度
     loadProgress();
     
-    // 确保至少有一个关卡解锁
-    if (level_unlocked_status.isEmpty() || !level_unlocked_status[0]) {
-        unlockLevel(0);
-    }
-    
-    qDebug() << "关卡管理器初始化完成，共" << getLevelCount() << "个关卡";
+    qCDebug(lcLevel) << "关卡管理器初始化完成，共" << getLevelCount() << "个关卡";
     return true;
 }
 
@@ -63,16 +68,7 @@ bool LevelManager::initializeDirectories()
     QDir dir;
     if (!dir.exists(levels_directory)) {
         if (!dir.mkpath(levels_directory)) {
-            qDebug() << "无法创建关卡目录：" << levels_directory;
-            return false;
-        }
-    }
-    
-    // 确保进度文件目录存在
-    QString progressDir = QFileInfo(progress_file_path).absolutePath();
-    if (!dir.exists(progressDir)) {
-        if (!dir.mkpath(progressDir)) {
-            qDebug() << "无法创建进度文件目录：" << progressDir;
+            qCDebug(lcLevel) << "无法创建关卡目录：" << levels_directory;
             return false;
         }
     }
@@ -82,29 +78,152 @@ bool LevelManager::initializeDirectories()
 
 bool LevelManager::isValidLevelIndex(int levelIndex) const
 {
-    return levelIndex >= 0 && levelIndex < level_data_list.size();
+    return levelIndex >= 0 && levelIndex < level_catalog.size();
+}
+
+const LevelCatalogEntry& LevelManager::getLevelInfo(int levelIndex) const
+{
+    static const LevelCatalogEntry emptyEntry;
+    return isValidLevelIndex(levelIndex) ? level_catalog[levelIndex] : emptyEntry;
 }
 
 LevelData* LevelManager::getLevelData(int levelIndex)
 {
     if (!isValidLevelIndex(levelIndex)) {
-        qDebug() << "无效的关卡索引：" << levelIndex;
+        qCDebug(lcLevel) << "无效的关卡索引：" << levelIndex;
         return nullptr;
     }
-    return level_data_list[levelIndex];
+
+    // 已驻留：标记为最近使用
+    if (LevelData* cached = loaded_levels.value(levelIndex, nullptr)) {
+        loaded_order.removeOne(levelIndex);
+        loaded_order.append(levelIndex);
+        return cached;
+    }
+
+    LevelData* levelData = loadLevelFromFile(level_catalog[levelIndex].file_path);
+    if (!levelData) {
+        return nullptr;
+    }
+    cacheLevel(levelIndex, levelData);
+    return levelData;
+}
+
+void LevelManager::cacheLevel(int levelIndex, LevelData* levelData)
+{
+    delete loaded_levels.value(levelIndex, nullptr);
+    loaded_levels.insert(levelIndex, levelData);
+    loaded_order.removeOne(levelIndex);
+    loaded_order.append(levelIndex);
+
+    // 从最久未使用的开始淘汰，跳过当前关卡与刚放入的关卡
+    for (int i = 0; i < loaded_order.size() && loaded_levels.size() > LEVEL_CACHE_SIZE; ) {
+        const int victim = loaded_order[i];
+        if (victim == levelIndex || victim == current_level_index) {
+            ++i;
+            continue;
+        }
+        delete loaded_levels.take(victim);
+        loaded_order.removeAt(i);
+    }
+}
+
+void LevelManager::clearLoadedLevels()
+{
+    qDeleteAll(loaded_levels);
+    loaded_levels.clear();
+    loaded_order.clear();
+}
+
+void LevelManager::describeLevel(LevelCatalogEntry& entry, const LevelData& levelData)
+{
+    entry.name = levelData.getLevelName();
+    entry.description = levelData.getLevelDescription();
+    entry.width = levelData.getWidth();
+    entry.height = levelData.getHeight();
+    entry.element_count = levelData.getGameElements().size();
+}
+
+void LevelManager::stampLevelFile(LevelCatalogEntry& entry)
+{
+    const QFileInfo info(entry.file_path);
+    entry.modified_ms = info.lastModified().toMSecsSinceEpoch();
+    entry.file_size = info.size();
+
+    QFile file(entry.file_path);
+    entry.source_hash = file.open(QIODevice::ReadOnly)
+                        ? QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1)
+                        : QByteArray();
+}
+
+QHash<QString, LevelCatalogEntry> LevelManager::readCatalogIndex() const
+{
+    QHash<QString, LevelCatalogEntry> index;
+    QFile file(catalog_index_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return index;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_15);
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint32 count = 0;
+    in >> magic >> version >> count;
+    if (magic != CATALOG_MAGIC || version != CATALOG_VERSION) {
+        return index;
+    }
+
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString fileName;
+        LevelCatalogEntry entry;
+        qint32 width = 0;
+        qint32 height = 0;
+        qint32 elementCount = 0;
+        in >> fileName >> entry.modified_ms >> entry.file_size >> entry.source_hash
+           >> entry.name >> entry.description >> width >> height >> elementCount;
+        entry.width = width;
+        entry.height = height;
+        entry.element_count = elementCount;
+        index.insert(fileName, entry);
+    }
+    if (in.status() != QDataStream::Ok) {
+        qCDebug(lcLevel) << "关卡目录索引已损坏，将重新扫描";
+        index.clear();
+    }
+    return index;
+}
+
+bool LevelManager::writeCatalogIndex() const
+{
+    QFile file(catalog_index_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(lcLevel) << "无法保存关卡目录索引：" << catalog_index_path;
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_15);
+    out << CATALOG_MAGIC << CATALOG_VERSION << quint32(level_catalog.size());
+    for (const LevelCatalogEntry& entry : level_catalog) {
+        out << QFileInfo(entry.file_path).fileName() << entry.modified_ms << entry.file_size
+            << entry.source_hash << entry.name << entry.description
+            << qint32(entry.width) << qint32(entry.height) << qint32(entry.element_count);
+    }
+    return out.status() == QDataStream::Ok;
 }
 
 bool LevelManager::setCurrentLevel(int levelIndex)
 {
     if (!isValidLevelIndex(levelIndex)) {
-        qDebug() << "无法设置当前关卡，无效索引：" << levelIndex;
+        qCDebug(lcLevel) << "无法设置当前关卡，无效索引：" << levelIndex;
         return false;
     }
     
     if (current_level_index != levelIndex) {
         current_level_index = levelIndex;
         emit currentLevelChanged(levelIndex);
-        qDebug() << "当前关卡设置为：" << levelIndex;
+        qCDebug(lcLevel) << "当前关卡设置为：" << levelIndex;
     }
     
     return true;
@@ -116,11 +235,7 @@ bool LevelManager::isLevelUnlocked(int levelIndex) const
         return false;
     }
     
-    if (levelIndex >= level_unlocked_status.size()) {
-        return false;
-    }
-    
-    return level_unlocked_status[levelIndex];
+    return ProgressStore::getInstance().isLevelUnlocked(levelIndex);
 }
 
 void LevelManager::unlockLevel(int levelIndex)
@@ -129,18 +244,8 @@ void LevelManager::unlockLevel(int levelIndex)
         return;
     }
     
-    // 确保解锁状态数组足够大
-    while (level_unlocked_status.size() <= levelIndex) {
-        level_unlocked_status.append(false);
-    }
-    
-    if (!level_unlocked_status[levelIndex]) {
-        level_unlocked_status[levelIndex] = true;
+    if (ProgressStore::getInstance().unlockLevel(levelIndex)) {
         emit levelUnlockStatusChanged(levelIndex, true);
-        qDebug() << "关卡" << levelIndex << "已解锁";
-        
-        // 保存进度
-        saveProgress();
     }
 }
 
@@ -150,22 +255,13 @@ void LevelManager::markLevelCompleted(int levelIndex)
         return;
     }
     
-    // 确保完成状态数组足够大
-    while (level_completed_status.size() <= levelIndex) {
-        level_completed_status.append(false);
-    }
-    
-    if (!level_completed_status[levelIndex]) {
-        level_completed_status[levelIndex] = true;
-        qDebug() << "关卡" << levelIndex << "已完成";
+    if (ProgressStore::getInstance().markLevelCompleted(levelIndex)) {
+        qCDebug(lcLevel) << "关卡" << levelIndex << "已完成";
         
         // 自动解锁下一关
         if (levelIndex + 1 < getLevelCount()) {
             unlockLevel(levelIndex + 1);
         }
-        
-        // 保存进度
-        saveProgress();
     }
 }
 
@@ -175,11 +271,7 @@ bool LevelManager::isLevelCompleted(int levelIndex) const
         return false;
     }
     
-    if (levelIndex >= level_completed_status.size()) {
-        return false;
-    }
-    
-    return level_completed_status[levelIndex];
+    return ProgressStore::getInstance().isLevelCompleted(levelIndex);
 }
 
 QString LevelManager::generateLevelFileName(int levelIndex) const
@@ -197,11 +289,11 @@ LevelData* LevelManager::loadLevelFromFile(const QString& filePath)
     LevelData* levelData = new LevelData();
     
     if (levelData->loadFromFile(filePath)) {
-        qDebug() << "从文件加载关卡成功：" << filePath;
+        qCDebug(lcLevel) << "从文件加载关卡成功：" << filePath;
         return levelData;
     } else {
         delete levelData;
-        qDebug() << "从文件加载关卡失败：" << filePath;
+        qCDebug(lcLevel) << "从文件加载关卡失败：" << filePath;
         return nullptr;
     }
 }
@@ -209,29 +301,54 @@ LevelData* LevelManager::loadLevelFromFile(const QString& filePath)
 bool LevelManager::loadAllLevels()
 {
     // 清空现有数据
-    qDeleteAll(level_data_list);
-    level_data_list.clear();
+    clearLoadedLevels();
+    level_catalog.clear();
     
     QDir levelsDir(levels_directory);
     QStringList levelFiles = levelsDir.entryList(QStringList() << "level_*.json" << "tutorial_level.json", QDir::Files, QDir::Name);
     
     if (levelFiles.isEmpty()) {
-        qDebug() << "未找到关卡文件";
+        qCDebug(lcLevel) << "未找到关卡文件";
         return false;
     }
     
-    // 按文件名排序加载
+    // 按文件名排序建立目录：修改时间与大小未变的文件直接使用索引中的元数据，
+    // 其余文件才完整解析一次（解析结果不驻留）
+    const QHash<QString, LevelCatalogEntry> index = readCatalogIndex();
+    bool indexChanged = index.size() != levelFiles.size();
     for (const QString& fileName : levelFiles) {
-        QString filePath = levelsDir.absoluteFilePath(fileName);
-        LevelData* levelData = loadLevelFromFile(filePath);
-        
-        if (levelData) {
-            level_data_list.append(levelData);
-            qDebug() << "加载关卡：" << levelData->getLevelName();
+        const QString filePath = levelsDir.absoluteFilePath(fileName);
+        const QFileInfo info(filePath);
+
+        auto it = index.constFind(fileName);
+        if (it != index.constEnd() &&
+            it->modified_ms == info.lastModified().toMSecsSinceEpoch() &&
+            it->file_size == info.size()) {
+            LevelCatalogEntry entry = it.value();
+            entry.file_path = filePath;
+            level_catalog.append(entry);
+            continue;
+        }
+
+        LevelData levelData;
+        if (!levelData.loadFromFile(filePath)) {
+            qCDebug(lcLevel) << "从文件加载关卡失败：" << filePath;
+            continue;
         }
+        LevelCatalogEntry entry;
+        entry.file_path = filePath;
+        describeLevel(entry, levelData);
+        stampLevelFile(entry);
+        level_catalog.append(entry);
+        indexChanged = true;
+        qCDebug(lcLevel) << "索引关卡：" << entry.name;
+    }
+
+    if (indexChanged) {
+        writeCatalogIndex();
     }
     
-    return !level_data_list.isEmpty();
+    return !level_catalog.isEmpty();
 }
 
 bool LevelManager::saveLevelData(int levelIndex)
@@ -239,15 +356,27 @@ bool LevelManager::saveLevelData(int levelIndex)
     if (!isValidLevelIndex(levelIndex)) {
         return false;
     }
+
+    // 未加载的关卡与文件一致，无需保存
+    LevelData* levelData = loaded_levels.value(levelIndex, nullptr);
+    if (!levelData) {
+        return true;
+    }
     
     QString filePath = getLevelFilePath(levelIndex);
-    bool success = level_data_list[levelIndex]->saveToFile(filePath);
+    bool success = levelData->saveToFile(filePath);
     
     if (success) {
+        LevelCatalogEntry& entry = level_catalog[levelIndex];
+        describeLevel(entry, *levelData);
+        if (QFileInfo(entry.file_path) == QFileInfo(filePath)) {
+            stampLevelFile(entry);
+        }
+        writeCatalogIndex();
         emit levelDataChanged(levelIndex);
-        qDebug() << "保存关卡" << levelIndex << "成功";
+        qCDebug(lcLevel) << "保存关卡" << levelIndex << "成功";
     } else {
-        qDebug() << "保存关卡" << levelIndex << "失败";
+        qCDebug(lcLevel) << "保存关卡" << levelIndex << "失败";
     }
     
     return success;
@@ -257,7 +386,7 @@ bool LevelManager::saveAllLevels()
 {
     bool allSuccess = true;
     
-    for (int i = 0; i < level_data_list.size(); ++i) {
+    for (int i = 0; i < level_catalog.size(); ++i) {
         if (!saveLevelData(i)) {
             allSuccess = false;
         }
@@ -268,68 +397,17 @@ bool LevelManager::saveAllLevels()
 
 bool LevelManager::saveProgress()
 {
-    QJsonObject progressObj;
-    progressObj["currentLevel"] = current_level_index;
-    
-    // 保存解锁状态
-    QJsonArray unlockedArray;
-    for (bool unlocked : level_unlocked_status) {
-        unlockedArray.append(unlocked);
-    }
-    progressObj["unlockedLevels"] = unlockedArray;
-    
-    // 保存完成状态
-    QJsonArray completedArray;
-    for (bool completed : level_completed_status) {
-        completedArray.append(completed);
-    }
-    progressObj["completedLevels"] = completedArray;
-    
-    QFile file(progress_file_path);
-    if (!file.open(QIODevice::WriteOnly)) {
-        qDebug() << "无法保存进度文件：" << progress_file_path;
-        return false;
-    }
-    
-    QJsonDocument doc(progressObj);
-    file.write(doc.toJson());
+    // 进度由 ProgressStore 延迟写入，这里只同步当前关卡
+    ProgressStore::getInstance().setCurrentLevel(current_level_index);
     return true;
 }
 
 bool LevelManager::loadProgress()
 {
-    QFile file(progress_file_path);
-    if (!file.open(QIODevice::ReadOnly)) {
-        qDebug() << "进度文件不存在，使用默认进度";
-        return false;
-    }
-    
-    QByteArray data = file.readAll();
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    
-    if (!doc.isObject()) {
-        qDebug() << "进度文件格式错误";
-        return false;
-    }
-    
-    QJsonObject progressObj = doc.object();
-    current_level_index = progressObj["currentLevel"].toInt(0);
-    
-    // 加载解锁状态
-    level_unlocked_status.clear();
-    QJsonArray unlockedArray = progressObj["unlockedLevels"].toArray();
-    for (const auto& value : unlockedArray) {
-        level_unlocked_status.append(value.toBool());
-    }
-    
-    // 加载完成状态
-    level_completed_status.clear();
-    QJsonArray completedArray = progressObj["completedLevels"].toArray();
-    for (const auto& value : completedArray) {
-        level_completed_status.append(value.toBool());
+    current_level_index = ProgressStore::getInstance().getCurrentLevel();
+    if (!isValidLevelIndex(current_level_index)) {
+        current_level_index = 0;
     }
-    
-    qDebug() << "加载游戏进度成功";
     return true;
 }
 
@@ -339,17 +417,21 @@ int LevelManager::createNewLevel(const QString& levelName, const QString& descri
     newLevel->setLevelName(levelName);
     newLevel->setLevelDescription(description);
     
-    int newIndex = level_data_list.size();
-    level_data_list.append(newLevel);
+    int newIndex = level_catalog.size();
+    LevelCatalogEntry entry;
+    entry.file_path = getLevelFilePath(newIndex);
+    level_catalog.append(entry);
+    cacheLevel(newIndex, newLevel);
     
     // 保存新关卡
     if (saveLevelData(newIndex)) {
-        qDebug() << "创建新关卡：" << levelName << "索引：" << newIndex;
+        qCDebug(lcLevel) << "创建新关卡：" << levelName << "索引：" << newIndex;
         return newIndex;
     } else {
         // 保存失败，移除关卡
-        level_data_list.removeLast();
-        delete newLevel;
+        level_catalog.removeLast();
+        loaded_order.removeOne(newIndex);
+        delete loaded_levels.take(newIndex);
         return -1;
     }
 }
@@ -364,24 +446,32 @@ bool LevelManager::deleteLevel(int levelIndex)
     QString filePath = getLevelFilePath(levelIndex);
     QFile::remove(filePath);
     
-    // 删除内存中的数据
-    delete level_data_list[levelIndex];
-    level_data_list.removeAt(levelIndex);
-    
-    // 调整解锁和完成状态
-    if (levelIndex < level_unlocked_status.size()) {
-        level_unlocked_status.removeAt(levelIndex);
+    // 删除内存中的数据，之后的已加载关卡索引前移
+    level_catalog.removeAt(levelIndex);
+    QHash<int, LevelData*> shifted;
+    for (auto it = loaded_levels.constBegin(); it != loaded_levels.constEnd(); ++it) {
+        if (it.key() == levelIndex) {
+            delete it.value();
+        } else {
+            shifted.insert(it.key() > levelIndex ? it.key() - 1 : it.key(), it.value());
+        }
     }
-    if (levelIndex < level_completed_status.size()) {
-        level_completed_status.removeAt(levelIndex);
+    loaded_levels = shifted;
+    loaded_order.removeOne(levelIndex);
+    for (int& index : loaded_order) {
+        if (index > levelIndex) index--;
     }
+    writeCatalogIndex();
+    
+    // 调整解锁和完成状态
+    ProgressStore::getInstance().removeLevel(levelIndex);
     
     // 调整当前关卡索引
     if (current_level_index >= levelIndex && current_level_index > 0) {
         current_level_index--;
     }
     
-    qDebug() << "删除关卡" << levelIndex;
+    qCDebug(lcLevel) << "删除关卡" << levelIndex;
     return true;
 }
 
@@ -392,7 +482,10 @@ int LevelManager::duplicateLevel(int sourceIndex, const QString& newName)
     }
     
     // 创建新关卡
-    LevelData* sourceLevel = level_data_list[sourceIndex];
+    LevelData* sourceLevel = getLevelData(sourceIndex);
+    if (!sourceLevel) {
+        return -1;
+    }
     LevelData* newLevel = new LevelData();
     
     // 复制数据
@@ -400,17 +493,21 @@ int LevelManager::duplicateLevel(int sourceIndex, const QString& newName)
     newLevel->loadFromJson(sourceJson);
     newLevel->setLevelName(newName);
     
-    int newIndex = level_data_list.size();
-    level_data_list.append(newLevel);
+    int newIndex = level_catalog.size();
+    LevelCatalogEntry entry;
+    entry.file_path = getLevelFilePath(newIndex);
+    level_catalog.append(entry);
+    cacheLevel(newIndex, newLevel);
     
     // 保存新关卡
     if (saveLevelData(newIndex)) {
-        qDebug() << "复制关卡：" << newName << "索引：" << newIndex;
+        qCDebug(lcLevel) << "复制关卡：" << newName << "索引：" << newIndex;
         return newIndex;
     } else {
         // 保存失败，移除关卡
-        level_data_list.removeLast();
-        delete newLevel;
+        level_catalog.removeLast();
+        loaded_order.removeOne(newIndex);
+        delete loaded_levels.take(newIndex);
         return -1;
     }
 }
@@ -493,15 +590,20 @@ void LevelManager::createDefaultTutorialLevel()
     reachExit.description = "到达终点";
     tutorialLevel->addObjective(reachExit);
     
-    // 添加到关卡列表
-    level_data_list.append(tutorialLevel);
+    // 添加到关卡目录（保存前常驻内存）
+    LevelCatalogEntry entry;
+    entry.file_path = tutorialFilePath;
+    describeLevel(entry, *tutorialLevel);
+    stampLevelFile(entry);
+    level_catalog.append(entry);
+    cacheLevel(level_catalog.size() - 1, tutorialLevel);
     
-    qDebug() << "创建默认教学关卡";
+    qCDebug(lcLevel) << "创建默认教学关卡";
 }
 
 void LevelManager::createDefaultLevels()
 {
-    qDebug() << "创建默认关卡集合";
+    qCDebug(lcLevel) << "创建默认关卡集合";
     
     // 创建教学关卡
     createDefaultTutorialLevel();
@@ -511,15 +613,6 @@ void LevelManager::createDefaultLevels()
     // 保存所有关卡
     saveAllLevels();
     
-    // 初始化进度状态
-    level_unlocked_status.clear();
-    level_completed_status.clear();
-    
-    for (int i = 0; i < level_data_list.size(); ++i) {
-        level_unlocked_status.append(i == 0); // 只解锁第一关
-        level_completed_status.append(false);
-    }
-    
-    // 保存进度
-    saveProgress();
+    // 初始化进度状态（只解锁第一关）
+    ProgressStore::getInstance().reset(level_catalog.size());
 }
@@ -14,13 +14,33 @@
 #include <QVector>
 #include <QString>
 #include <QDir>
+#include <QHash>
+#include <QList>
 #include <QStandardPaths>
 
+/**
+ * @struct LevelCatalogEntry
+ * @brief 关卡目录项：只含关卡选择所需的元数据，完整关卡按需加载
+ */
+struct LevelCatalogEntry {
+    QString file_path;          ///< 关卡文件路径
+    QString name;               ///< 关卡名称
+    QString description;        ///< 关卡描述
+    int width = 0;              ///< 宽度（格子数）
+    int height = 0;             ///< 高度（格子数）
+    int element_count = 0;      ///< 元素数量
+    qint64 modified_ms = 0;     ///< 文件修改时间（毫秒）
+    qint64 file_size = 0;       ///< 文件大小（字节）
+    QByteArray source_hash;     ///< 文件内容SHA-1
+};
+
 /**
  * @class LevelManager
  * @brief 关卡管理器，使用单例模式管理所有关卡数据
  * 
  * 负责：
+ * - 维护关卡目录（启动时只扫描元数据并缓存在索引文件中）
+ * - 按需加载完整关卡，常驻内存的关卡数受 LEVEL_CACHE_SIZE 限制
  * - 加载和保存关卡文件
  * - 管理关卡进度和解锁状态
  * - 提供关卡数据访问接口
@@ -49,10 +69,20 @@ public:
      * @brief 获取关卡数量
      * @return int 关卡总数
      */
-    int getLevelCount() const { return level_data_list.size(); }
+    int getLevelCount() const { return level_catalog.size(); }
+
+    /**
+     * @brief 获取关卡目录项（不加载完整关卡）
+     * @param levelIndex 关卡索引（从0开始）
+     * @return const LevelCatalogEntry& 目录项，索引无效时返回空目录项
+     */
+    const LevelCatalogEntry& getLevelInfo(int levelIndex) const;
     
     /**
-     * @brief 获取指定关卡数据
+     * @brief 获取指定关卡数据（未驻留时从文件加载）
+     *
+     * 返回的指针由关卡管理器持有。当前关卡不会被淘汰，其他关卡的指针
+     * 在后续调用本函数时可能失效，调用者不应长期保存。
      * @param levelIndex 关卡索引（从0开始）
      * @return LevelData* 关卡数据指针，失败返回nullptr
      */
@@ -108,8 +138,8 @@ public:
     // === 文件操作 ===
     
     /**
-     * @brief 加载所有关卡文件
-     * @return bool 是否加载成功
+     * @brief 扫描关卡目录，建立关卡目录（只读取元数据，未变化的文件直接使用索引缓存）
+     * @return bool 是否找到关卡
      */
     bool loadAllLevels();
     
@@ -232,13 +262,13 @@ private:
     LevelManager(const LevelManager&) = delete;
     LevelManager& operator=(const LevelManager&) = delete;
     
-    QVector<LevelData*> level_data_list;        ///< 关卡数据列表
-    QVector<bool> level_unlocked_status;        ///< 关卡解锁状态
-    QVector<bool> level_completed_status;       ///< 关卡完成状态
+    QVector<LevelCatalogEntry> level_catalog;   ///< 关卡目录（按索引）
+    QHash<int, LevelData*> loaded_levels;       ///< 已加载的完整关卡（索引 -> 数据）
+    QList<int> loaded_order;                    ///< 已加载关卡的使用顺序（末尾最近使用）
     
     int current_level_index;                    ///< 当前关卡索引
     QString levels_directory;                   ///< 关卡文件目录
-    QString progress_file_path;                 ///< 进度文件路径
+    QString catalog_index_path;                 ///< 关卡目录索引文件路径
     
     /**
      * @brief 初始化目录结构
@@ -253,6 +283,43 @@ private:
      */
     bool isValidLevelIndex(int levelIndex) const;
     
+    /**
+     * @brief 把已加载关卡放入缓存并按LRU淘汰（当前关卡与刚放入的关卡不淘汰）
+     * @param levelIndex 关卡索引
+     * @param levelData 关卡数据（所有权转移给管理器）
+     */
+    void cacheLevel(int levelIndex, LevelData* levelData);
+
+    /**
+     * @brief 释放所有已加载的完整关卡
+     */
+    void clearLoadedLevels();
+
+    /**
+     * @brief 由关卡数据更新目录项的元数据
+     * @param entry 目录项
+     * @param levelData 关卡数据
+     */
+    static void describeLevel(LevelCatalogEntry& entry, const LevelData& levelData);
+
+    /**
+     * @brief 由文件重新记录目录项的修改时间、大小与哈希
+     * @param entry 目录项（使用其 file_path）
+     */
+    static void stampLevelFile(LevelCatalogEntry& entry);
+
+    /**
+     * @brief 读取目录索引文件
+     * @return QHash<QString, LevelCatalogEntry> 文件名 -> 目录项
+     */
+    QHash<QString, LevelCatalogEntry> readCatalogIndex() const;
+
+    /**
+     * @brief 写入目录索引文件
+     * @return bool 是否写入成功
+     */
+    bool writeCatalogIndex() const;
+
     /**
      * @brief 生成关卡文件名
      * @param levelIndex 关卡索引
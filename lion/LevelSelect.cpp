@@ -2,13 +2,9 @@
 #include "Config.h"
 #include <QLabel>
 #include <QPixmap>
+#include "TextureCache.h"
+#include "ProgressStore.h"
 #include <QPalette>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QJsonValue>
-#include <QFile>
-#include <QDir>
 #include <QApplication>
 #include <QDebug>
 
@@ -29,7 +25,7 @@ void LevelSelect::ui_load()
 {
     this->resize(1280, 720);
     
-    QPixmap back(":/images/pickbkg.jpg");
+    QPixmap back = TextureCache::getInstance().pixmap(":/images/pickbkg.jpg");
     QPixmap scaledBack = back.scaled(this->size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
     QPalette palette;
     palette.setBrush(QPalette::Window, scaledBack);
@@ -58,7 +54,7 @@ void LevelSelect::ui_load()
     }
     
     // 创建返回按钮背景图片
-    QPixmap backBtnImg(":/ui/Picture/backbtn.png");
+    QPixmap backBtnImg = TextureCache::getInstance().pixmap(":/ui/Picture/backbtn.png");
     const int backBtnWidth = 100;
     const int backBtnHeight = 40;
     QPixmap scaledBackBtn = backBtnImg.scaled(backBtnWidth, backBtnHeight, Qt::KeepAspectRatio, Qt::SmoothTransformation);
@@ -140,61 +136,10 @@ LevelSelect::~LevelSelect()
 
 void LevelSelect::loadGameProgress()
 {
-    QString saveDir = getDataDirectory();
-    QString saveFilePath = saveDir + "/game_progress.json";
-    
-    QFile saveFile(saveFilePath);
-    if (!saveFile.exists()) {
-        // 如果文件不存在，只有第1关解锁
-        qDebug() << "游戏进度文件不存在，只有第1关解锁";
-        
-        // 重置所有关卡为锁定状态
-        for (int i = 0; i < MAX_LEVELS; ++i) {
-            level_unlocked[i] = false;
-        }
-        
-        // 第1关默认解锁
-        level_unlocked[0] = true;
-        
-        // 更新所有按钮的样式
-        for (int i = 0; i < MAX_LEVELS; ++i) {
-            updateLevelButtonStyle(i);
-        }
-        
-        return;
-    }
-    
-    if (saveFile.open(QIODevice::ReadOnly)) {
-        QByteArray saveData = saveFile.readAll();
-        saveFile.close();
-        
-        QJsonDocument loadDoc = QJsonDocument::fromJson(saveData);
-        QJsonObject progress = loadDoc.object();
-        
-        // 获取已解锁的关卡列表
-        QJsonArray unlockedLevels = progress["unlockedLevels"].toArray();
-        
-        // 重置所有关卡为锁定状态
-        for (int i = 0; i < MAX_LEVELS; ++i) {
-            level_unlocked[i] = false;
-        }
-        
-        // 根据进度数据解锁关卡
-        for (const QJsonValue& value : unlockedLevels) {
-            int levelIndex = value.toInt() - 1;  // 转换为0基索引
-            if (levelIndex >= 0 && levelIndex < MAX_LEVELS) {
-                level_unlocked[levelIndex] = true;
-                qDebug() << "关卡" << (levelIndex + 1) << "已解锁";
-            }
-        }
-        
-        // 更新所有按钮的样式
-        for (int i = 0; i < MAX_LEVELS; ++i) {
-            updateLevelButtonStyle(i);
-        }
-        
-        qDebug() << "游戏进度加载完成";
-    } else {
-        qDebug() << "无法读取游戏进度文件：" << saveFilePath;
+    // 解锁状态直接取自内存中的进度，无需读文件
+    const ProgressStore& progress = ProgressStore::getInstance();
+    for (int i = 0; i < MAX_LEVELS; ++i) {
+        level_unlocked[i] = progress.isLevelUnlocked(i);
+        updateLevelButtonStyle(i);
     }
 }
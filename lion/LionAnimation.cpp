@@ -1,7 +1,8 @@
 #include "LionAnimation.h"
 #include <QPainter>
-#include <QDebug>
 #include "Config.h"
+#include "TextureCache.h"
+#include "LogCategories.h"
 #include <QDir>
 #include <QRegularExpression>
 #include <QFileInfo>
@@ -20,116 +21,183 @@ LionAnimation::LionAnimation(QWidget *parent) : QWidget(parent)
 }
 
 // 加载帧
-void LionAnimation::loadAnimationFrames() {
-    // 清空原有帧
-    left_frames.clear();
-    right_frames.clear();
-    jump_frames.clear();
-
-    // 加载向左帧：自动枚举 left_*.png/jpg，优先 png，并按数值序排序
-    {
-        QDir dir(":/images");
-        QStringList files = dir.entryList({"left_*.png", "left_*.jpg"}, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
-        QRegularExpression re("^left_(\\d+)\\.(png|jpg)$");
-        QMap<int, QString> chosen;
+QMap<int, QString> LionAnimation::chooseFrameFiles(const QString& prefix, bool mixExtensions)
+{
+    QDir dir(":/images");
+    QRegularExpression re(QString("^%1_(\\d+)\\.(png|jpg)$").arg(prefix));
+    QMap<int, QString> chosen;
+    if (mixExtensions) {
+        // 按编号逐帧选择，同编号 png 优先于 jpg
+        QStringList files = dir.entryList({prefix + "_*.png", prefix + "_*.jpg"}, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
         for (const QString &name : files) {
             QRegularExpressionMatch m = re.match(name);
             if (!m.hasMatch()) continue;
             int idx = m.captured(1).toInt();
             QString ext = m.captured(2).toLower();
             if (!chosen.contains(idx) || ext == "png") {
-                chosen[idx] = name;
+                chosen[idx] = QString(":/images/%1").arg(name); // 若存在同编号png覆盖jpg
             }
         }
-        QList<int> keys = chosen.keys();
-        std::sort(keys.begin(), keys.end());
-        for (int idx : keys) {
-            QString path = QString(":/images/%1").arg(chosen[idx]);
-            QPixmap img(path);
+    } else {
+        // 选择数量更多的一组（PNG或JPG），避免混用
+        QStringList pngFiles = dir.entryList({prefix + "_*.png"}, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
+        QStringList jpgFiles = dir.entryList({prefix + "_*.jpg"}, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
+        QStringList filesToUse = (jpgFiles.size() > pngFiles.size()) ? jpgFiles : pngFiles;
+        for (const QString &name : filesToUse) {
+            QRegularExpressionMatch m = re.match(name);
+            if (!m.hasMatch()) continue;
+            chosen[m.captured(1).toInt()] = QString(":/images/%1").arg(name);
+        }
+    }
+    return chosen;  // QMap 按编号数值序排列
+}
+
+QStringList LionAnimation::framePaths()
+{
+    QStringList paths;
+    paths << chooseFrameFiles("left", true).values();
+    paths << chooseFrameFiles("right", true).values();
+    paths << chooseFrameFiles("jump", false).values();
+    return paths;
+}
+
+void LionAnimation::loadAnimationFrames() {
+    // 清空原有帧
+    left_frames.clear();
+    right_frames.clear();
+    jump_frames.clear();
+
+    // 源帧由纹理缓存提供（启动画面期间已在后台解码）
+    TextureCache& textures = TextureCache::getInstance();
+
+    // 加载向左帧：自动枚举 left_*.png/jpg，优先 png，并按数值序排序
+    {
+        const QMap<int, QString> chosen = chooseFrameFiles("left", true);
+        for (const QString &path : chosen) {
+            QImage img = textures.image(path);
             if (img.isNull()) {
-                qDebug() << "向左帧加载失败：" << path;
+                qCDebug(lcRender) << "向左帧加载失败：" << path;
                 continue;
             }
-            left_frames.append(img.scaled(300, 300, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+            left_frames.append(img);
         }
         if (left_frames.isEmpty()) {
-            qDebug() << "没有可用的向左帧资源（left_*.png/jpg）";
+            qCDebug(lcRender) << "没有可用的向左帧资源（left_*.png/jpg）";
         }
     }
 
     // 加载向右帧：自动枚举 right_*.png/jpg，优先 png，并按数值序排序
     {
-        QDir dir(":/images");
-        // 收集匹配的文件名
-        QStringList files = dir.entryList({"right_*.png", "right_*.jpg"}, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
-        QRegularExpression re("^right_(\\d+)\\.(png|jpg)$");
-        // 使用数字索引映射，png 优先
-        QMap<int, QString> chosen;
-        for (const QString &name : files) {
-            QRegularExpressionMatch m = re.match(name);
-            if (!m.hasMatch()) continue;
-            int idx = m.captured(1).toInt();
-            QString ext = m.captured(2).toLower();
-            if (!chosen.contains(idx) || ext == "png") {
-                chosen[idx] = name; // 若存在同编号png覆盖jpg
-            }
-        }
-        QList<int> keys = chosen.keys();
-        std::sort(keys.begin(), keys.end());
-        for (int idx : keys) {
-            QString path = QString(":/images/%1").arg(chosen[idx]);
-            QPixmap img(path);
+        const QMap<int, QString> chosen = chooseFrameFiles("right", true);
+        for (const QString &path : chosen) {
+            QImage img = textures.image(path);
             if (img.isNull()) {
-                qDebug() << "向右帧加载失败：" << path;
+                qCDebug(lcRender) << "向右帧加载失败：" << path;
                 continue;
             }
-            right_frames.append(img.scaled(300, 300, Qt::KeepAspectRatio, Qt::SmoothTransformation));
+            right_frames.append(img);
         }
         if (right_frames.isEmpty()) {
-            qDebug() << "没有可用的向右帧资源（right_*.png/jpg）";
+            qCDebug(lcRender) << "没有可用的向右帧资源（right_*.png/jpg）";
         }
     }
 
     // 加载跳跃帧：选择数量更多的一组（PNG或JPG），按数值序排序，避免混用造成朝向交替
     {
-        QDir dir(":/images");
-        QStringList pngFiles = dir.entryList({"jump_*.png"}, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
-        QStringList jpgFiles = dir.entryList({"jump_*.jpg"}, QDir::Files | QDir::NoDotAndDotDot, QDir::Name);
-        QStringList filesToUse = (jpgFiles.size() > pngFiles.size()) ? jpgFiles : pngFiles;
-        QRegularExpression re("^jump_(\\d+)\\.(png|jpg)$");
-        QMap<int, QString> chosen;
-        for (const QString &name : filesToUse) {
-            QRegularExpressionMatch m = re.match(name);
-            if (!m.hasMatch()) continue;
-            int idx = m.captured(1).toInt();
-            chosen[idx] = name; // 不混用：同一组文件名
-        }
-        QList<int> keys = chosen.keys();
-        std::sort(keys.begin(), keys.end());
-        for (int idx : keys) {
-            QString path = QString(":/images/%1").arg(chosen[idx]);
-            QPixmap img(path);
+        const QMap<int, QString> chosen = chooseFrameFiles("jump", false);
+        for (auto it = chosen.constBegin(); it != chosen.constEnd(); ++it) {
+            QImage img = textures.image(it.value());
             if (img.isNull()) {
-                qDebug() << "跳跃帧加载失败：" << path;
+                qCDebug(lcRender) << "跳跃帧加载失败：" << it.value();
                 continue;
             }
-            QPixmap scaled = img.scaled(300, 300, Qt::KeepAspectRatio, Qt::SmoothTransformation);
             // 注意：根据你的资源说明，jump_1、jump_3 是向左的 => 编号为奇数的帧需要镜像为右向
-            if (idx % 2 == 1) {
-                scaled = QPixmap::fromImage(scaled.toImage().mirrored(true, false));
+            if (it.key() % 2 == 1) {
+                img = img.mirrored(true, false);
             }
-            jump_frames.append(scaled);
+            jump_frames.append(img);
         }
         if (jump_frames.isEmpty()) {
-            qDebug() << "没有可用的跳跃帧资源（jump_*.png/jpg）";
+            qCDebug(lcRender) << "没有可用的跳跃帧资源（jump_*.png/jpg）";
         }
+    }
+
+    // 源帧变化后图集需要重建
+    atlas = QPixmap();
 }
+
+void LionAnimation::buildAtlas(const QSize& frameSize, qreal dpr)
+{
+    const QSize cell = frameSize * dpr;
+    if (!atlas.isNull() && cell == atlas_cell) return;
+    atlas_cell = cell;
+
+    // 每行一组帧：向左、向右、跳跃（右向）、跳跃（左向，预先镜像）
+    const int columns = qMax(1, qMax(left_frames.size(), qMax(right_frames.size(), jump_frames.size())));
+    QImage sheet(cell.width() * columns, cell.height() * AtlasRowCount, QImage::Format_ARGB32_Premultiplied);
+    sheet.fill(Qt::transparent);
+
+    QPainter painter(&sheet);
+    auto packRow = [&](AtlasRow row, const QVector<QImage>& frames, bool mirror) {
+        for (int i = 0; i < frames.size(); ++i) {
+            // 直接缩放到屏幕上的尺寸（与原先按比例缩放后拉伸到角色矩形的效果一致）
+            QImage scaled = frames[i].scaled(cell, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+            if (mirror) scaled = scaled.mirrored(true, false);
+            painter.drawImage(i * cell.width(), row * cell.height(), scaled);
+        }
+    };
+    packRow(RowLeft, left_frames, false);
+    packRow(RowRight, right_frames, false);
+    packRow(RowJumpRight, jump_frames, false);
+    packRow(RowJumpLeft, jump_frames, true);
+    painter.end();
+
+    atlas = QPixmap::fromImage(sheet);
+}
+
+QRect LionAnimation::currentFrameRect() const
+{
+    if (atlas.isNull()) return QRect();
+
+    // 定时器停止时显示首帧
+    const int frame = (frameTimer && !frameTimer->isActive()) ? 0 : currentFrame;
+    AtlasRow row;
+    int column = 0;
+    switch (currentType) {
+    case Left:
+        if (left_frames.isEmpty()) return QRect();
+        row = RowLeft;
+        column = frame % left_frames.size();
+        break;
+    case Right:
+        if (right_frames.isEmpty()) return QRect();
+        row = RowRight;
+        column = frame % right_frames.size();
+        break;
+    case Jump:
+        if (jump_frames.isEmpty()) return QRect();
+        row = facingRight ? RowJumpRight : RowJumpLeft;
+        column = frame % jump_frames.size();
+        break;
+    case IdleLeft:
+        if (left_frames.isEmpty()) return QRect();
+        row = RowLeft;
+        break;
+    case IdleRight:
+        if (right_frames.isEmpty()) return QRect();
+        row = RowRight;
+        break;
+    default:
+        return QRect();  // 未播放动画
+    }
+    return QRect(column * atlas_cell.width(), row * atlas_cell.height(),
+                 atlas_cell.width(), atlas_cell.height());
 }
 
 // 启动向左循环动画
 void LionAnimation::startLeftLoop() {
     if (left_frames.isEmpty()) {
-        qDebug() << "没有向左帧，无法播放动画";
+        LJ_HOT_DEBUG(lcRender) << "没有向左帧，无法播放动画";
         return;
     }
     currentType = Left;
@@ -142,7 +210,7 @@ void LionAnimation::startLeftLoop() {
 // 启动向右循环动画
 void LionAnimation::startRightLoop() {
     if (right_frames.isEmpty()) {
-        qDebug() << "没有向右帧，无法播放动画";
+        LJ_HOT_DEBUG(lcRender) << "没有向右帧，无法播放动画";
         return;
     }
     currentType = Right;
@@ -155,7 +223,7 @@ void LionAnimation::startRightLoop() {
 // 启动跳跃循环动画（保留上次朝向）
 void LionAnimation::startJumpLoop() {
     if (jump_frames.isEmpty()) {
-        qDebug() << "没有跳跃帧，无法播放动画";
+        LJ_HOT_DEBUG(lcRender) << "没有跳跃帧，无法播放动画";
         return;
     }
     currentType = Jump;
@@ -211,44 +279,18 @@ void LionAnimation::paintEvent(QPaintEvent *event) {
     Q_UNUSED(event);
     QPainter painter(this);
 
-    // 绘制当前帧（居中显示）
-    QPixmap currentImg;
-    switch (currentType) {
-    case Left:
-        if (!left_frames.isEmpty()) {
-            currentImg = (frameTimer && !frameTimer->isActive()) ? left_frames.first() : left_frames[ currentFrame < left_frames.size() ? currentFrame : 0 ];
-        }
-        break;
-    case Right:
-        if (!right_frames.isEmpty()) {
-            currentImg = (frameTimer && !frameTimer->isActive()) ? right_frames.first() : right_frames[ currentFrame < right_frames.size() ? currentFrame : 0 ];
-        }
-        break;
-    case Jump:
-        if (!jump_frames.isEmpty()) {
-            currentImg = (frameTimer && !frameTimer->isActive()) ? jump_frames.first() : jump_frames[ currentFrame < jump_frames.size() ? currentFrame : 0 ];
-            if (!facingRight && !currentImg.isNull()) {
-                currentImg = QPixmap::fromImage(currentImg.toImage().mirrored(true, false));
-            }
-        }
-        break;
-    case IdleLeft:
-        if (!left_frames.isEmpty()) currentImg = left_frames.first();
-        break;
-    case IdleRight:
-        if (!right_frames.isEmpty()) currentImg = right_frames.first();
-        break;
-    default:
+    if (currentType == None) {
         // 未播放动画时，显示提示文字
         painter.drawText(rect(), Qt::AlignCenter, "点击按钮播放动画");
         return;
     }
 
-    // 绘制图片（居中）
-    if (!currentImg.isNull()) {
-        int x = (width() - currentImg.width()) / 2;
-        int y = (height() - currentImg.height()) / 2;
-        painter.drawPixmap(x, y, currentImg);
+    // 按预览尺寸构建图集后，从图集中取当前帧（居中）
+    buildAtlas(QSize(300, 300), devicePixelRatioF());
+    const QRect source = currentFrameRect();
+    if (!source.isNull()) {
+        const QRect target((width() - 300) / 2, (height() - 300) / 2, 300, 300);
+        painter.drawPixmap(target, atlas, source);
     } else {
         painter.drawText(rect(), Qt::AlignCenter, "缺少动画帧资源");
     }
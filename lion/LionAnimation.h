@@ -3,8 +3,11 @@
 
 #include <QWidget>
 #include <QPixmap>
+#include <QImage>
 #include <QVector>
 #include <QTimer>
+#include <QMap>
+#include <QStringList>
 
 class LionAnimation : public QWidget
 {
@@ -15,9 +18,22 @@ public:
     // 独立动画帧间隔（毫秒），与 GAME_TICK 解耦
     static constexpr int FRAME_INTERVAL_MS = 100;
 
-    // 加载动画帧（原函数保留）
+    // 加载动画源帧（原始尺寸，不缩放）
     void loadAnimationFrames();
 
+    // 动画用到的全部源帧路径（供启动时预加载）
+    static QStringList framePaths();
+
+    // 按屏幕上的帧尺寸把所有帧（含预先镜像的左向跳跃帧）打包进一张图集；
+    // 尺寸与像素比不变时直接复用
+    void buildAtlas(const QSize& frameSize, qreal dpr);
+
+    // 当前帧在图集中的源矩形（像素），没有可显示的帧时为空矩形
+    QRect currentFrameRect() const;
+
+    // 动画图集，配合 currentFrameRect() 按源矩形绘制
+    const QPixmap& getAtlas() const { return atlas; }
+
 signals:
 
 public slots:
@@ -32,9 +48,9 @@ public slots:
     // 帧切换定时器槽函数
     void onFrameTimerTimeout();
 public:
-    QVector<QPixmap> left_frames;   // 向左帧序列
-    QVector<QPixmap> right_frames;  // 向右帧序列
-    QVector<QPixmap> jump_frames;   // 跳跃帧序列
+    QVector<QImage> left_frames;    // 向左源帧序列
+    QVector<QImage> right_frames;   // 向右源帧序列
+    QVector<QImage> jump_frames;    // 跳跃源帧序列（均为右向）
 
     QTimer* frameTimer;  // 控制帧切换的定时器
     int currentFrame;    // 当前显示的帧索引
@@ -52,31 +68,23 @@ public:
 
     // 新增：在不改变动画类型的情况下更新朝向（用于空中转向）
     void setFacingRight(bool right) { facingRight = right; }
-public:
-    // 公共接口：获取当前帧
-    QPixmap getCurrentFrame() const {
-        switch (currentType) {
-        case Left:
-            return left_frames.isEmpty() ? QPixmap() : (frameTimer && !frameTimer->isActive() ? left_frames.first() : left_frames[currentFrame]);
-        case Right:
-            return right_frames.isEmpty() ? QPixmap() : (frameTimer && !frameTimer->isActive() ? right_frames.first() : right_frames[currentFrame]);
-        case Jump: {
-            if (jump_frames.isEmpty()) return QPixmap();
-            QPixmap base = (frameTimer && !frameTimer->isActive()) ? jump_frames.first() : jump_frames[currentFrame];
-            if (!facingRight && !base.isNull()) {
-                return QPixmap::fromImage(base.toImage().mirrored(true, false));
-            }
-            return base;
-        }
-        case IdleLeft:
-            return left_frames.isEmpty() ? QPixmap() : left_frames.first();
-        case IdleRight:
-            return right_frames.isEmpty() ? QPixmap() : right_frames.first();
-        default:
-            return QPixmap();  // 默认返回空图
-        }
-    }
+private:
+    // 枚举 :/images 下 prefix_编号 的帧文件，返回 编号 -> 资源路径；
+    // mixExtensions 为真时逐帧选择（png优先），否则整组使用数量更多的扩展名
+    static QMap<int, QString> chooseFrameFiles(const QString& prefix, bool mixExtensions);
+
+    // 图集中每一行存放的帧组
+    enum AtlasRow {
+        RowLeft,
+        RowRight,
+        RowJumpRight,
+        RowJumpLeft,
+        AtlasRowCount
+    };
 
+    QPixmap atlas;       // 动画图集（像素比为1，每格为屏幕上的物理像素尺寸）
+    QSize atlas_cell;    // 图集每格的像素尺寸
+public:
     // 重写绘制事件，显示当前帧
     void paintEvent(QPaintEvent *event) override;
 };
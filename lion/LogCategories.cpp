@@ -0,0 +1,18 @@
+/**
+ * @file LogCategories.cpp
+ * @brief 日志类别定义
+ * @author 开发团队
+ * @date 2025-11-29
+ */
+
+#include "LogCategories.h"
+
+Q_LOGGING_CATEGORY(lcLevel, "lion.level")
+Q_LOGGING_CATEGORY(lcAudio, "lion.audio")
+Q_LOGGING_CATEGORY(lcRender, "lion.render")
+
+// 热路径类别只输出 info 及以上级别，调试输出需显式打开
+Q_LOGGING_CATEGORY(lcPlayer, "lion.player", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcSim, "lion.sim", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcObjective, "lion.objective", QtInfoMsg)
+Q_LOGGING_CATEGORY(lcAudioPlay, "lion.audio.play", QtInfoMsg)
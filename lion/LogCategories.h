@@ -0,0 +1,40 @@
+/**
+ * @file LogCategories.h
+ * @brief 分类日志：按模块划分日志类别，热路径调试输出在发布版本中不参与编译
+ * @author 开发团队
+ * @date 2025-11-29
+ * @version 1.0.0
+ */
+
+#ifndef LOGCATEGORIES_H
+#define LOGCATEGORIES_H
+
+#include <QLoggingCategory>
+
+// 普通类别：调试输出默认开启，可用 QT_LOGGING_RULES 关闭（如 "lion.level.debug=false"）
+Q_DECLARE_LOGGING_CATEGORY(lcLevel)         ///< lion.level：关卡加载、保存与目录，游戏进度与录像文件
+Q_DECLARE_LOGGING_CATEGORY(lcAudio)         ///< lion.audio：背景音乐、音量设置与混音器
+Q_DECLARE_LOGGING_CATEGORY(lcRender)        ///< lion.render：纹理与动画帧加载、帧耗时统计
+
+// 热路径类别：每tick或每次操作都可能输出，调试输出默认关闭，
+// 开发时用 QT_LOGGING_RULES="lion.player.debug=true" 等规则按需打开
+Q_DECLARE_LOGGING_CATEGORY(lcPlayer)        ///< lion.player：玩家移动与按键状态
+Q_DECLARE_LOGGING_CATEGORY(lcSim)           ///< lion.sim：模拟世界事件（收集、开关、箭矢）
+Q_DECLARE_LOGGING_CATEGORY(lcObjective)     ///< lion.objective：目标进度
+Q_DECLARE_LOGGING_CATEGORY(lcAudioPlay)     ///< lion.audio.play：音效触发
+
+/**
+ * @def LJ_HOT_DEBUG
+ * @brief 热路径调试输出
+ *
+ * 发布版本（Qt 在非Debug配置下定义 QT_NO_DEBUG）中展开为永不执行的空语句，
+ * 流式参数不会被求值，也不会检查类别；定义 LJ_ENABLE_HOT_LOG 可在发布版本中保留。
+ * 开发版本中等同于 qCDebug，运行时按类别过滤。
+ */
+#if defined(QT_NO_DEBUG) && !defined(LJ_ENABLE_HOT_LOG)
+#define LJ_HOT_DEBUG(category) while (false) QMessageLogger().noDebug()
+#else
+#define LJ_HOT_DEBUG(category) qCDebug(category)
+#endif
+
+#endif // LOGCATEGORIES_H
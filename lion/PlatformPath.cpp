@@ -0,0 +1,134 @@
+/**
+ * @file PlatformPath.cpp
+ * @brief 移动平台路径实现
+ * @author 开发团队
+ * @date 2025-11-29
+ */
+
+#include "PlatformPath.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+
+constexpr int EASE_STEPS = 256;         ///< 缓动表分段数
+constexpr int EASE_SHIFT = 16;          ///< 缓动表数值精度（Q16）
+
+/**
+ * @brief 编译期计算 (1 - cos(πi/N)) / 2 的Q16表
+ *
+ * 用泰勒级数在编译期求值，不依赖运行时数学库，各平台的表逐位相同。
+ */
+constexpr std::array<qint64, EASE_STEPS + 1> makeEaseTable()
+{
+    std::array<qint64, EASE_STEPS + 1> table{};
+    const double pi = 3.14159265358979323846;
+    for (int i = 0; i <= EASE_STEPS; ++i) {
+        const double x = pi * i / EASE_STEPS;
+        double term = 1.0;
+        double cosine = 1.0;
+        for (int k = 1; k <= 20; ++k) {
+            term *= -x * x / ((2 * k - 1) * (2 * k));
+            cosine += term;
+        }
+        table[i] = static_cast<qint64>((1.0 - cosine) / 2.0 * (1 << EASE_SHIFT) + 0.5);
+    }
+    return table;
+}
+
+constexpr std::array<qint64, EASE_STEPS + 1> EASE_TABLE = makeEaseTable();
+
+} // namespace
+
+PlatformPath::PlatformPath()
+    : path_length(0)
+    , cycle_length(0)
+    , speed(0)
+    , easing(PlatformEasing::Linear)
+    , loop(false)
+{
+}
+
+void PlatformPath::build(const QPointF& start, const PlatformProps& props)
+{
+    points.clear();
+    cumulative.clear();
+
+    points.append(Fx::Point::fromPointF(start));
+    for (const QPointF& point : props.via) {
+        points.append(Fx::Point::fromPointF(point));
+    }
+    points.append(Fx::Point::fromPointF(props.end_pos));
+    loop = props.loop;
+    if (loop) {
+        points.append(points.first());     // 闭合路径
+    }
+
+    // 段长只在构建时开方一次，之后全部为定点运算
+    path_length = 0;
+    cumulative.append(0);
+    for (int i = 1; i < points.size(); ++i) {
+        const double dx = Fx::toReal(points[i].x - points[i - 1].x);
+        const double dy = Fx::toReal(points[i].y - points[i - 1].y);
+        path_length += Fx::fromReal(std::sqrt(dx * dx + dy * dy));
+        cumulative.append(path_length);
+    }
+
+    speed = Fx::fromReal(props.speed);
+    easing = props.easing;
+    cycle_length = (speed > 0 && path_length > 0) ? (loop ? path_length : 2 * path_length) : 0;
+}
+
+Fx::Point PlatformPath::positionAt(qint64 tick) const
+{
+    if (cycle_length == 0) return start();
+
+    qint64 distance = (tick * speed) % cycle_length;
+    if (distance >= path_length) {
+        distance = cycle_length - distance;     // 往返的返程
+    }
+    if (easing == PlatformEasing::Sine) {
+        distance = easeSine(distance, path_length);
+    }
+    return pointAlong(distance);
+}
+
+Fx::Point PlatformPath::pointAlong(qint64 distance) const
+{
+    // 找到 distance 所在的段：cumulative[segment] <= distance < cumulative[segment + 1]
+    const int segment = int(std::upper_bound(cumulative.constBegin(), cumulative.constEnd(), distance)
+                            - cumulative.constBegin()) - 1;
+    if (segment >= points.size() - 1) return points.last();
+
+    const Fx::Point& from = points[segment];
+    const Fx::Point& to = points[segment + 1];
+    const qint64 segmentLength = cumulative[segment + 1] - cumulative[segment];
+    if (segmentLength == 0) return from;
+
+    const qint64 along = distance - cumulative[segment];
+    return Fx::Point(from.x + Fx::Fixed(qint64(to.x - from.x) * along / segmentLength),
+                     from.y + Fx::Fixed(qint64(to.y - from.y) * along / segmentLength));
+}
+
+qint64 PlatformPath::easeSine(qint64 distance, qint64 length)
+{
+    if (length <= 0) return 0;
+
+    // 查表并在相邻两项之间线性插值
+    const qint64 scaled = distance * EASE_STEPS;
+    const qint64 index = scaled / length;
+    if (index >= EASE_STEPS) return length;
+    const qint64 remainder = scaled - index * length;
+    const qint64 eased = EASE_TABLE[index] + (EASE_TABLE[index + 1] - EASE_TABLE[index]) * remainder / length;
+    return (eased * length) >> EASE_SHIFT;
+}
+
+QRectF PlatformPath::travelBounds(const QSizeF& size) const
+{
+    QRectF bounds;
+    for (const Fx::Point& point : points) {
+        bounds = bounds.united(QRectF(point.toPointF(), size));
+    }
+    return bounds;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file PlatformPath.h
+ * @brief 移动平台路径：由tick数直接求位置的闭式时间函数
+ * @author 开发团队
+ * @date 2025-11-29
+ * @version 1.0.0
+ */
+
+#ifndef PLATFORMPATH_H
+#define PLATFORMPATH_H
+
+#include <QVector>
+#include <QRectF>
+#include "FixedPoint.h"
+#include "LevelData.h"
+
+/**
+ * @class PlatformPath
+ * @brief 折线路径上的周期运动
+ *
+ * 平台位置只取决于tick数：已走路程 = tick × 速度，对一个周期（往返为两倍
+ * 路径长，循环为闭合路径长）取余后映射到路径上，再按速度曲线缓动。逐tick
+ * 累加速度的旧做法会积累误差，需要在终点附近按阈值吸附；闭式求值没有误差，
+ * 休眠的平台醒来时也直接得到正确位置。全部为定点整数运算。
+ */
+class PlatformPath
+{
+public:
+    PlatformPath();
+
+    /**
+     * @brief 由关卡配置构建路径
+     * @param start 起点（平台左上角）
+     * @param props 平台属性（路径点、速度、曲线、是否循环）
+     */
+    void build(const QPointF& start, const PlatformProps& props);
+
+    /**
+     * @brief 求某tick时平台的位置
+     * @param tick tick数（从关卡开始计）
+     * @return Fx::Point 平台左上角位置
+     */
+    Fx::Point positionAt(qint64 tick) const;
+
+    /**
+     * @brief 平台是否静止（无速度或路径长度为0）
+     */
+    bool isStatic() const { return cycle_length == 0; }
+
+    /**
+     * @brief 路径起点
+     */
+    Fx::Point start() const { return points.isEmpty() ? Fx::Point() : points.first(); }
+
+    /**
+     * @brief 平台在整个行程中扫过的外接矩形
+     * @param size 平台大小
+     */
+    QRectF travelBounds(const QSizeF& size) const;
+
+private:
+    /**
+     * @brief 沿路径走过一段路程后的位置
+     * @param distance 路程（定点，0 ~ path_length）
+     */
+    Fx::Point pointAlong(qint64 distance) const;
+
+    /**
+     * @brief 正弦缓动：把 [0, length] 内的路程映射为缓动后的路程
+     */
+    static qint64 easeSine(qint64 distance, qint64 length);
+
+    QVector<Fx::Point> points;          ///< 路径点（循环路径末尾重复起点）
+    QVector<qint64> cumulative;         ///< 到各路径点的累计路程（定点）
+    qint64 path_length;                 ///< 路径总长（定点）
+    qint64 cycle_length;                ///< 一个周期的路程（定点，0为静止）
+    Fx::Fixed speed;                    ///< 每tick路程（定点）
+    PlatformEasing easing;              ///< 速度曲线
+    bool loop;                          ///< 是否循环（否则往返）
+};
+
+#endif // PLATFORMPATH_H
@@ -0,0 +1,281 @@
+/**
+ * @file ProgressStore.cpp
+ * @brief 游戏进度存储实现
+ * @author 开发团队
+ * @date 2025-11-28
+ */
+
+#include "ProgressStore.h"
+#include "Config.h"
+#include "LogCategories.h"
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+
+ProgressStore& ProgressStore::getInstance()
+{
+    static ProgressStore instance;
+    return instance;
+}
+
+ProgressStore::ProgressStore(QObject* parent)
+    : QObject(parent)
+    , current_level(0)
+    , last_level(0)
+{
+    QString dataDir = getDataDirectory();
+    file_path = dataDir + "/progress.json";
+
+    write_timer.setSingleShot(true);
+    write_timer.setInterval(WRITE_DELAY_MS);
+    connect(&write_timer, &QTimer::timeout, this, &ProgressStore::submitWrite);
+
+    write_context.moveToThread(&write_thread);
+    write_thread.setObjectName("ProgressWriter");
+    write_thread.start(QThread::LowPriority);
+
+    // 退出前写完未保存的修改，写入线程随之结束
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, [this]() {
+            flush();
+            write_thread.quit();
+            write_thread.wait();
+        });
+    }
+
+    load();
+}
+
+ProgressStore::~ProgressStore()
+{
+    write_thread.quit();
+    write_thread.wait();
+}
+
+bool ProgressStore::isLevelUnlocked(int levelIndex) const
+{
+    return flagAt(unlocked_levels, levelIndex);
+}
+
+bool ProgressStore::isLevelCompleted(int levelIndex) const
+{
+    return flagAt(completed_levels, levelIndex);
+}
+
+bool ProgressStore::unlockLevel(int levelIndex)
+{
+    if (levelIndex < 0 || isLevelUnlocked(levelIndex)) {
+        return false;
+    }
+    setFlag(unlocked_levels, levelIndex, true);
+    qCDebug(lcLevel) << "关卡" << levelIndex << "已解锁";
+    markDirty();
+    return true;
+}
+
+bool ProgressStore::markLevelCompleted(int levelIndex)
+{
+    if (levelIndex < 0 || isLevelCompleted(levelIndex)) {
+        return false;
+    }
+    setFlag(completed_levels, levelIndex, true);
+    markDirty();
+    return true;
+}
+
+void ProgressStore::setCurrentLevel(int levelIndex)
+{
+    if (current_level != levelIndex) {
+        current_level = levelIndex;
+        markDirty();
+    }
+}
+
+void ProgressStore::setLastLevel(int levelIndex)
+{
+    if (last_level != levelIndex) {
+        last_level = levelIndex;
+        markDirty();
+    }
+}
+
+void ProgressStore::removeLevel(int levelIndex)
+{
+    if (levelIndex < 0) {
+        return;
+    }
+    if (levelIndex < unlocked_levels.size()) {
+        unlocked_levels.removeAt(levelIndex);
+    }
+    if (levelIndex < completed_levels.size()) {
+        completed_levels.removeAt(levelIndex);
+    }
+    if (last_level > levelIndex) {
+        last_level--;
+    }
+    // 第一关始终可玩
+    setFlag(unlocked_levels, 0, true);
+    markDirty();
+}
+
+void ProgressStore::reset(int levelCount)
+{
+    unlocked_levels.fill(false, qMax(levelCount, 1));
+    completed_levels.fill(false, qMax(levelCount, 0));
+    unlocked_levels[0] = true; // 只解锁第一关
+    last_level = 0;
+    markDirty();
+}
+
+void ProgressStore::flush()
+{
+    if (write_timer.isActive()) {
+        write_timer.stop();
+        submitWrite();
+    }
+    if (write_thread.isRunning()) {
+        // 等待写入线程处理完已提交的数据
+        QMetaObject::invokeMethod(&write_context, [this]() { writePending(); },
+                                  Qt::BlockingQueuedConnection);
+    }
+}
+
+void ProgressStore::load()
+{
+    QFile file(file_path);
+    if (file.open(QIODevice::ReadOnly)) {
+        QJsonDocument doc = QJsonDocument::fromJson(file.readAll());
+        if (doc.isObject()) {
+            QJsonObject progressObj = doc.object();
+            current_level = progressObj["currentLevel"].toInt(0);
+            last_level = progressObj["lastLevel"].toInt(0);
+
+            for (const auto& value : progressObj["unlockedLevels"].toArray()) {
+                unlocked_levels.append(value.toBool());
+            }
+            for (const auto& value : progressObj["completedLevels"].toArray()) {
+                completed_levels.append(value.toBool());
+            }
+            qCDebug(lcLevel) << "加载游戏进度成功";
+        } else {
+            qCDebug(lcLevel) << "进度文件格式错误：" << file_path;
+        }
+    } else {
+        qCDebug(lcLevel) << "进度文件不存在，使用默认进度";
+    }
+
+    // 合并旧版进度文件（unlockedLevels 为以1开始的关卡编号）
+    QString legacyPath = QFileInfo(file_path).absolutePath() + "/game_progress.json";
+    QFile legacyFile(legacyPath);
+    if (legacyFile.open(QIODevice::ReadOnly)) {
+        QJsonObject legacy = QJsonDocument::fromJson(legacyFile.readAll()).object();
+        for (const auto& value : legacy["unlockedLevels"].toArray()) {
+            int levelIndex = value.toInt() - 1;
+            if (levelIndex >= 0) {
+                setFlag(unlocked_levels, levelIndex, true);
+            }
+        }
+        if (legacy.contains("lastLevel")) {
+            last_level = qMax(0, legacy["lastLevel"].toInt() - 1);
+        }
+        legacy_file_path = legacyPath;
+        qCDebug(lcLevel) << "已合并旧版进度文件：" << legacyPath;
+    }
+
+    // 确保至少第一关解锁
+    bool changed = !legacy_file_path.isEmpty();
+    if (!isLevelUnlocked(0)) {
+        setFlag(unlocked_levels, 0, true);
+        changed = true;
+    }
+    if (changed) {
+        markDirty();
+    }
+}
+
+void ProgressStore::markDirty()
+{
+    // 连续修改只重新计时，延时结束后合并为一次写入
+    write_timer.start();
+}
+
+void ProgressStore::submitWrite()
+{
+    QJsonObject progressObj;
+    progressObj["currentLevel"] = current_level;
+    progressObj["lastLevel"] = last_level;
+
+    QJsonArray unlockedArray;
+    for (bool unlocked : unlocked_levels) {
+        unlockedArray.append(unlocked);
+    }
+    progressObj["unlockedLevels"] = unlockedArray;
+
+    QJsonArray completedArray;
+    for (bool completed : completed_levels) {
+        completedArray.append(completed);
+    }
+    progressObj["completedLevels"] = completedArray;
+    progressObj["saveTime"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+
+    QByteArray data = QJsonDocument(progressObj).toJson();
+
+    QMutexLocker locker(&pending_mutex);
+    pending_data = data;
+    if (!write_queued) {
+        write_queued = true;
+        QMetaObject::invokeMethod(&write_context, [this]() { writePending(); }, Qt::QueuedConnection);
+    }
+}
+
+void ProgressStore::writePending()
+{
+    QByteArray data;
+    QString legacyPath;
+    {
+        QMutexLocker locker(&pending_mutex);
+        write_queued = false;
+        data.swap(pending_data);
+        legacyPath = legacy_file_path;
+    }
+    if (data.isEmpty()) {
+        return;
+    }
+
+    QDir().mkpath(QFileInfo(file_path).absolutePath());
+    QSaveFile file(file_path);
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCDebug(lcLevel) << "无法保存进度文件：" << file_path << file.errorString();
+        return;
+    }
+
+    // 合并后的进度已落盘，旧文件不再需要
+    if (!legacyPath.isEmpty()) {
+        QFile::remove(legacyPath);
+        QMutexLocker locker(&pending_mutex);
+        legacy_file_path.clear();
+    }
+}
+
+void ProgressStore::setFlag(QVector<bool>& flags, int index, bool value)
+{
+    if (index < 0) {
+        return;
+    }
+    if (flags.size() <= index) {
+        flags.resize(index + 1);    // 新增项默认为false
+    }
+    flags[index] = value;
+}
+
+bool ProgressStore::flagAt(const QVector<bool>& flags, int index)
+{
+    return index >= 0 && index < flags.size() && flags[index];
+}
@@ -0,0 +1,133 @@
+/**
+ * @file ProgressStore.h
+ * @brief 游戏进度存储：常驻内存查询，后台线程合并写入并原子提交
+ * @author 开发团队
+ * @date 2025-11-28
+ * @version 1.0.0
+ */
+
+#ifndef PROGRESSSTORE_H
+#define PROGRESSSTORE_H
+
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QMutex>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+
+/**
+ * @class ProgressStore
+ * @brief 游戏进度服务（单例）
+ *
+ * 进度只在首次使用时从 data/progress.json 读取一次，之后的查询都来自内存。
+ * 修改会启动一个短延时，延时结束时把当前状态序列化后交给写入线程；写入线程
+ * 只保留最新的一份待写数据（写入期间的多次修改合并为一次），并通过
+ * QSaveFile 原子提交，写入中途退出不会留下半个文件。
+ *
+ * 旧版本的 data/game_progress.json（以1开始的关卡编号列表）会在加载时合并，
+ * 合并后的进度首次写入成功后删除旧文件。
+ *
+ * 公共接口只能在GUI线程调用。
+ */
+class ProgressStore : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int WRITE_DELAY_MS = 200;  ///< 修改后延迟写入的时间（合并连续修改）
+
+    /**
+     * @brief 获取单例实例（首次调用时加载进度）
+     * @return ProgressStore& 单例引用
+     */
+    static ProgressStore& getInstance();
+
+    // === 查询（内存） ===
+
+    bool isLevelUnlocked(int levelIndex) const;
+    bool isLevelCompleted(int levelIndex) const;
+    int getCurrentLevel() const { return current_level; }
+    int getLastLevel() const { return last_level; }
+
+    // === 修改（延迟写入） ===
+
+    /**
+     * @brief 解锁关卡
+     * @param levelIndex 关卡索引（从0开始）
+     * @return bool 状态是否发生变化
+     */
+    bool unlockLevel(int levelIndex);
+
+    /**
+     * @brief 标记关卡为已完成
+     * @param levelIndex 关卡索引（从0开始）
+     * @return bool 状态是否发生变化
+     */
+    bool markLevelCompleted(int levelIndex);
+
+    void setCurrentLevel(int levelIndex);
+    void setLastLevel(int levelIndex);
+
+    /**
+     * @brief 删除关卡后，之后关卡的进度前移
+     * @param levelIndex 被删除的关卡索引
+     */
+    void removeLevel(int levelIndex);
+
+    /**
+     * @brief 重置进度：只解锁第一关
+     * @param levelCount 关卡数量
+     */
+    void reset(int levelCount);
+
+    /**
+     * @brief 立即写入未保存的修改并等待写入完成（退出前调用）
+     */
+    void flush();
+
+private:
+    explicit ProgressStore(QObject* parent = nullptr);
+    ~ProgressStore() override;
+    ProgressStore(const ProgressStore&) = delete;
+    ProgressStore& operator=(const ProgressStore&) = delete;
+
+    /**
+     * @brief 从进度文件加载，并合并旧版进度文件
+     */
+    void load();
+
+    /**
+     * @brief 标记进度已修改，启动延迟写入
+     */
+    void markDirty();
+
+    /**
+     * @brief 序列化当前状态并交给写入线程
+     */
+    void submitWrite();
+
+    /**
+     * @brief 写入线程：提交最新的待写数据
+     */
+    void writePending();
+
+    static void setFlag(QVector<bool>& flags, int index, bool value);
+    static bool flagAt(const QVector<bool>& flags, int index);
+
+    QVector<bool> unlocked_levels;      ///< 解锁状态（按关卡索引）
+    QVector<bool> completed_levels;     ///< 完成状态（按关卡索引）
+    int current_level;                  ///< 关卡管理器的当前关卡
+    int last_level;                     ///< 最近进入的关卡
+    QString file_path;                  ///< 进度文件路径
+    QString legacy_file_path;           ///< 待删除的旧进度文件（为空表示没有，受 pending_mutex 保护）
+
+    QTimer write_timer;                 ///< 延迟写入定时器（GUI线程）
+    QThread write_thread;               ///< 写入线程
+    QObject write_context;              ///< 写入线程中执行任务的上下文对象
+    QMutex pending_mutex;               ///< 保护待写数据与旧进度文件路径
+    QByteArray pending_data;            ///< 最新的待写数据
+    bool write_queued = false;          ///< 写入线程中是否已有待执行的写入任务
+};
+
+#endif // PROGRESSSTORE_H
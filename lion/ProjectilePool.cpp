@@ -0,0 +1,85 @@
+/**
+ * @file ProjectilePool.cpp
+ * @brief 固定容量、结构数组布局的箭矢池实现
+ * @author 开发团队
+ * @date 2025-11-27
+ */
+
+#include "ProjectilePool.h"
+
+ProjectilePool::ProjectilePool(int capacity)
+    : pool_capacity(qMax(1, capacity))
+    , high_water(0)
+{
+    pos_x.fill(0.0f, pool_capacity);
+    pos_y.fill(0.0f, pool_capacity);
+    vel_x.fill(0.0f, pool_capacity);
+    vel_y.fill(0.0f, pool_capacity);
+    size_x.fill(0.0f, pool_capacity);
+    size_y.fill(0.0f, pool_capacity);
+    active_mask.fill(0, pool_capacity);
+    free_slots.reserve(pool_capacity);
+}
+
+void ProjectilePool::clear()
+{
+    for (int i = 0; i < high_water; ++i) {
+        active_mask[i] = 0;
+    }
+    high_water = 0;
+    free_slots.clear();
+}
+
+int ProjectilePool::spawn(float x, float y, float vx, float vy, float w, float h)
+{
+    int slot;
+    if (!free_slots.isEmpty()) {
+        slot = free_slots.takeLast();
+    } else if (high_water < pool_capacity) {
+        slot = high_water++;
+    } else {
+        return -1;
+    }
+
+    pos_x[slot] = x;
+    pos_y[slot] = y;
+    vel_x[slot] = vx;
+    vel_y[slot] = vy;
+    size_x[slot] = w;
+    size_y[slot] = h;
+    active_mask[slot] = 1;
+    return slot;
+}
+
+void ProjectilePool::integrate(float minX, float minY, float maxX, float maxY)
+{
+    const int n = high_water;
+    float* px = pos_x.data();
+    float* py = pos_y.data();
+    const float* vx = vel_x.constData();
+    const float* vy = vel_y.constData();
+    quint8* active = active_mask.data();
+
+    // 无分支循环：失效槽位也照常积分（结果不会被读取），便于编译器向量化
+    for (int i = 0; i < n; ++i) {
+        const float x = px[i] + vx[i];
+        const float y = py[i] + vy[i];
+        px[i] = x;
+        py[i] = y;
+        const quint8 inside = (x >= minX) & (x <= maxX) & (y >= minY) & (y <= maxY);
+        active[i] &= inside;
+    }
+}
+
+void ProjectilePool::reclaim()
+{
+    while (high_water > 0 && !active_mask[high_water - 1]) {
+        high_water--;
+    }
+
+    // 从高到低压栈，栈顶为最小的空闲索引，新箭矢尽量集中在数组前部
+    free_slots.clear();
+    for (int i = high_water - 1; i >= 0; --i) {
+        if (!active_mask[i]) free_slots.append(i);
+    }
+}
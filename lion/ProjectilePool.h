@@ -0,0 +1,93 @@
+/**
+ * @file ProjectilePool.h
+ * @brief 固定容量、结构数组布局的箭矢池
+ * @author 开发团队
+ * @date 2025-11-27
+ * @version 1.0.0
+ */
+
+#ifndef PROJECTILEPOOL_H
+#define PROJECTILEPOOL_H
+
+#include <QVector>
+#include "Config.h"
+
+/**
+ * @class ProjectilePool
+ * @brief 箭矢池
+ *
+ * 位置、速度、尺寸与有效标记分别存放在连续数组中（SoA），运动积分与出界
+ * 判断是对数组的逐元素运算，编译器可以自动向量化。槽位在构造时一次性分配，
+ * 失效的槽位进入空闲表复用，运行期间不再分配内存。
+ *
+ * 只有 [0, highWater()) 范围内的槽位可能有效，遍历时用 isActive() 过滤。
+ */
+class ProjectilePool
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param capacity 槽位数
+     */
+    explicit ProjectilePool(int capacity = MAX_PROJECTILES);
+
+    /**
+     * @brief 清空所有箭矢
+     */
+    void clear();
+
+    /**
+     * @brief 发射一支箭矢（优先复用索引最小的空闲槽位）
+     * @param x 左上角X
+     * @param y 左上角Y
+     * @param vx 每tick X位移
+     * @param vy 每tick Y位移
+     * @param w 宽度
+     * @param h 高度
+     * @return int 槽位索引，池满时返回-1
+     */
+    int spawn(float x, float y, float vx, float vy, float w, float h);
+
+    /**
+     * @brief 所有箭矢前进一个tick，超出边界的失效
+     * @param minX 边界左
+     * @param minY 边界上
+     * @param maxX 边界右
+     * @param maxY 边界下
+     */
+    void integrate(float minX, float minY, float maxX, float maxY);
+
+    /**
+     * @brief 使箭矢失效（槽位在下次 reclaim() 时回收）
+     * @param slot 槽位索引
+     */
+    void kill(int slot) { active_mask[slot] = 0; }
+
+    /**
+     * @brief 回收失效槽位，重建空闲表并收缩高水位
+     */
+    void reclaim();
+
+    int capacity() const { return pool_capacity; }
+    int highWater() const { return high_water; }
+    bool isEmpty() const { return high_water == 0; }
+    bool isActive(int slot) const { return active_mask[slot] != 0; }
+
+    float posX(int slot) const { return pos_x[slot]; }
+    float posY(int slot) const { return pos_y[slot]; }
+    float velX(int slot) const { return vel_x[slot]; }
+    float velY(int slot) const { return vel_y[slot]; }
+    float sizeX(int slot) const { return size_x[slot]; }
+    float sizeY(int slot) const { return size_y[slot]; }
+
+private:
+    int pool_capacity;              ///< 槽位数
+    int high_water;                 ///< 曾使用过的最大槽位索引+1
+    QVector<float> pos_x, pos_y;    ///< 左上角位置
+    QVector<float> vel_x, vel_y;    ///< 每tick位移
+    QVector<float> size_x, size_y;  ///< 尺寸
+    QVector<quint8> active_mask;    ///< 有效标记（0/1）
+    QVector<int> free_slots;        ///< 高水位以下的空闲槽位（栈顶为最小索引）
+};
+
+#endif // PROJECTILEPOOL_H
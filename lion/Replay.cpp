@@ -0,0 +1,268 @@
+/**
+ * @file Replay.cpp
+ * @brief 输入录像与逐帧回放实现
+ * @author 开发团队
+ * @date 2025-11-25
+ */
+
+#include "Replay.h"
+#include "Config.h"
+#include "LogCategories.h"
+#include <QFile>
+#include <QDir>
+#include <QDataStream>
+#include <QDateTime>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+
+namespace {
+const quint32 REPLAY_MAGIC = 0x4C4A5250;   // "LJRP"
+const quint16 REPLAY_VERSION = 1;
+const quint32 REPLAY_MAX_TICKS = 24 * 60 * 60 * 1000 / GAME_TICK;    // 最长24小时
+}
+
+Replay::Replay()
+    : final_state_hash(0)
+    , has_final_state_hash(false)
+{
+}
+
+void Replay::begin(const QString& levelPath)
+{
+    level_path = levelPath;
+    level_hash = hashLevelFile(levelPath);
+    input_masks.clear();
+    final_state_hash = 0;
+    has_final_state_hash = false;
+}
+
+void Replay::record(const InputFrame& input)
+{
+    input_masks.append(encode(input));
+}
+
+void Replay::finish(quint64 stateHash)
+{
+    final_state_hash = stateHash;
+    has_final_state_hash = true;
+}
+
+bool Replay::saveToFile(const QString& filePath) const
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCDebug(lcLevel) << "无法创建录像文件：" << filePath;
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_15);
+    out << REPLAY_MAGIC << REPLAY_VERSION;
+    out << level_path << level_hash;
+    out << quint32(input_masks.size());
+
+    // 游程编码：(位掩码, 重复次数)
+    QVector<QPair<quint8, quint16>> runs;
+    for (quint8 mask : input_masks) {
+        if (!runs.isEmpty() && runs.last().first == mask && runs.last().second < 0xFFFF) {
+            runs.last().second++;
+        } else {
+            runs.append(qMakePair(mask, quint16(1)));
+        }
+    }
+    out << quint32(runs.size());
+    for (const auto& run : runs) {
+        out << run.first << run.second;
+    }
+
+    out << quint8(has_final_state_hash ? 1 : 0) << final_state_hash;
+    return out.status() == QDataStream::Ok;
+}
+
+bool Replay::loadFromFile(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCDebug(lcLevel) << "无法打开录像文件：" << filePath;
+        return false;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_15);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != REPLAY_MAGIC || version != REPLAY_VERSION) {
+        qCDebug(lcLevel) << "录像文件格式错误：" << filePath;
+        return false;
+    }
+
+    // 先读入局部变量，全部校验通过后才修改当前录像
+    QString levelPath;
+    QByteArray levelHash;
+    quint32 tickCount = 0;
+    quint32 runCount = 0;
+    in >> levelPath >> levelHash >> tickCount >> runCount;
+
+    // 长度字段来自文件，分配前先检查：每个游程占3字节，且至少覆盖1个tick
+    const qint64 runBytes = 3;
+    if (in.status() != QDataStream::Ok || tickCount > REPLAY_MAX_TICKS || runCount > tickCount ||
+        qint64(runCount) * runBytes > file.bytesAvailable()) {
+        qCDebug(lcLevel) << "录像文件已损坏：" << filePath;
+        return false;
+    }
+
+    QVector<quint8> masks;
+    masks.reserve(int(tickCount));
+    for (quint32 i = 0; i < runCount; ++i) {
+        quint8 mask = 0;
+        quint16 length = 0;
+        in >> mask >> length;
+        if (in.status() != QDataStream::Ok || quint32(masks.size()) + length > tickCount) {
+            qCDebug(lcLevel) << "录像文件已损坏：" << filePath;
+            return false;
+        }
+        masks.insert(masks.size(), length, mask);
+    }
+
+    quint8 hasHash = 0;
+    quint64 finalHash = 0;
+    in >> hasHash >> finalHash;
+
+    if (in.status() != QDataStream::Ok || quint32(masks.size()) != tickCount) {
+        qCDebug(lcLevel) << "录像文件已损坏：" << filePath;
+        return false;
+    }
+
+    level_path = levelPath;
+    level_hash = levelHash;
+    input_masks = masks;
+    final_state_hash = finalHash;
+    has_final_state_hash = hasHash != 0;
+    return true;
+}
+
+InputFrame Replay::frameAt(int tick) const
+{
+    if (tick < 0 || tick >= input_masks.size()) return InputFrame();
+    return decode(input_masks[tick]);
+}
+
+quint8 Replay::encode(const InputFrame& input)
+{
+    quint8 mask = 0;
+    if (input.left)  mask |= InputLeft;
+    if (input.right) mask |= InputRight;
+    if (input.jump)  mask |= InputJump;
+    if (input.dash)  mask |= InputDash;
+    return mask;
+}
+
+InputFrame Replay::decode(quint8 mask)
+{
+    InputFrame input;
+    input.left  = mask & InputLeft;
+    input.right = mask & InputRight;
+    input.jump  = mask & InputJump;
+    input.dash  = mask & InputDash;
+    return input;
+}
+
+QByteArray Replay::hashLevelFile(const QString& filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(file.readAll());
+    return hash.result();
+}
+
+QString Replay::defaultSavePath()
+{
+    QString replayDir = getDataDirectory() + "/replays";
+    QDir dir;
+    if (!dir.exists(replayDir)) {
+        dir.mkpath(replayDir);
+    }
+    return replayDir + "/replay_" +
+           QDateTime::currentDateTime().toString("yyyyMMdd_hhmmss") + ".ljr";
+}
+
+ReplayBenchResult Replay::runBenchmark(const Replay& replay, int iterations)
+{
+    LevelData levelData;
+    if (!levelData.loadFromFile(replay.getLevelPath())) {
+        return ReplayBenchResult();
+    }
+
+    // 预先解码，计时只覆盖模拟本身
+    QVector<InputFrame> frames;
+    frames.reserve(replay.getTickCount());
+    for (int i = 0; i < replay.getTickCount(); ++i) {
+        frames.append(replay.frameAt(i));
+    }
+
+    ReplayBenchResult result = runBenchmark(levelData, frames, iterations);
+    result.level_hash_matches = hashLevelFile(replay.getLevelPath()) == replay.getLevelHash();
+    result.state_hash_matches = result.level_loaded && result.deterministic && replay.hasFinalStateHash() &&
+                                result.final_state_hash == replay.getFinalStateHash();
+    return result;
+}
+
+ReplayBenchResult Replay::runBenchmark(LevelData& levelData, const QVector<InputFrame>& frames,
+                                       int iterations)
+{
+    ReplayBenchResult result;
+    result.level_loaded = true;
+
+    SimulationWorld world;
+    auto stepAll = [&world, &frames]() {
+        for (const InputFrame& input : frames) {
+            world.step(input);
+        }
+    };
+
+    // 计时回放不统计阶段耗时，避免计时器本身的开销计入总耗时
+    world.setStageTimingEnabled(false);
+    bool allMatched = true;
+    QElapsedTimer timer;
+    for (int run = 0; run < qMax(1, iterations); ++run) {
+        world.loadLevel(&levelData);
+        timer.start();
+        stepAll();
+        result.elapsed_ns += timer.nsecsElapsed();
+        result.total_ticks += frames.size();
+        result.iterations++;
+
+        // 每一轮都必须得到相同的结果
+        const quint64 stateHash = world.computeStateHash();
+        if (run == 0) {
+            result.final_state_hash = stateHash;
+        } else if (stateHash != result.final_state_hash) {
+            qCWarning(lcLevel) << "回放结果不确定：第" << run + 1 << "轮状态哈希不一致";
+            allMatched = false;
+            break;
+        }
+    }
+
+    // 单独回放一轮统计各阶段耗时，结果同样参与一致性检查
+    world.loadLevel(&levelData);
+    world.setStageTimingEnabled(true);
+    world.resetStageTimes();
+    stepAll();
+    if (world.computeStateHash() != result.final_state_hash) {
+        qCWarning(lcLevel) << "回放结果不确定：阶段统计轮状态哈希不一致";
+        allMatched = false;
+    }
+    result.stage_ticks = frames.size();
+    for (int i = 0; i < SimulationWorld::StageCount; ++i) {
+        result.stage_ns[i] = world.getStageTimeNs(static_cast<SimulationWorld::Stage>(i));
+    }
+
+    // 阶段统计轮保证至少比较了两轮，只回放一轮计时也能判定
+    result.deterministic = allMatched;
+    return result;
+}
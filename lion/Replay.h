@@ -0,0 +1,160 @@
+/**
+ * @file Replay.h
+ * @brief 输入录像与逐帧回放（含无界面基准测试）
+ * @author 开发团队
+ * @date 2025-11-25
+ * @version 1.0.0
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include "SimulationWorld.h"
+
+/**
+ * @struct ReplayBenchResult
+ * @brief 无界面回放基准测试结果
+ */
+struct ReplayBenchResult {
+    bool level_loaded = false;          ///< 关卡是否加载成功
+    bool level_hash_matches = false;    ///< 关卡文件哈希是否与录像一致
+    bool state_hash_matches = false;    ///< 最终状态哈希是否与录像一致
+    bool deterministic = false;         ///< 全部回放（计时轮与阶段统计轮，至少两轮）的最终状态哈希一致
+    quint64 final_state_hash = 0;       ///< 第一轮回放得到的最终状态哈希
+    int iterations = 0;                 ///< 计时回放次数（不含阶段统计轮）
+    qint64 total_ticks = 0;             ///< 计时回放累计tick数
+    qint64 elapsed_ns = 0;              ///< 计时回放总耗时（纳秒，不含阶段计时开销）
+    qint64 stage_ticks = 0;             ///< 阶段统计轮的tick数
+    qint64 stage_ns[SimulationWorld::StageCount] = {}; ///< 阶段统计轮中各阶段耗时（纳秒）
+};
+
+/**
+ * @class Replay
+ * @brief 输入录像
+ *
+ * 每个tick记录一个输入位掩码（A、D、K、Shift），连同关卡路径、关卡文件
+ * 哈希与结束时的状态哈希保存为紧凑的二进制文件（.ljr）。位掩码按游程编码
+ * 存储，长时间按住同一组按键只占几个字节。
+ */
+class Replay
+{
+public:
+    /**
+     * @enum InputBit
+     * @brief 输入位掩码
+     */
+    enum InputBit : quint8 {
+        InputLeft  = 1 << 0,    ///< A
+        InputRight = 1 << 1,    ///< D
+        InputJump  = 1 << 2,    ///< K
+        InputDash  = 1 << 3     ///< Shift
+    };
+
+    Replay();
+
+    /**
+     * @brief 开始新的录像（清空已有输入）
+     * @param levelPath 关卡文件路径
+     */
+    void begin(const QString& levelPath);
+
+    /**
+     * @brief 追加一个tick的输入
+     * @param input 输入
+     */
+    void record(const InputFrame& input);
+
+    /**
+     * @brief 记录结束时的模拟状态哈希
+     * @param stateHash 状态哈希
+     */
+    void finish(quint64 stateHash);
+
+    /**
+     * @brief 保存到文件
+     * @param filePath 文件路径
+     * @return bool 是否保存成功
+     */
+    bool saveToFile(const QString& filePath) const;
+
+    /**
+     * @brief 从文件加载
+     * @param filePath 文件路径
+     * @return bool 是否加载成功
+     */
+    bool loadFromFile(const QString& filePath);
+
+    /**
+     * @brief 获取指定tick的输入（超出录像长度返回空输入）
+     * @param tick tick序号（从0开始）
+     * @return InputFrame 输入
+     */
+    InputFrame frameAt(int tick) const;
+
+    int getTickCount() const { return input_masks.size(); }
+    QString getLevelPath() const { return level_path; }
+    QByteArray getLevelHash() const { return level_hash; }
+    quint64 getFinalStateHash() const { return final_state_hash; }
+    bool hasFinalStateHash() const { return has_final_state_hash; }
+    bool isEmpty() const { return input_masks.isEmpty(); }
+
+    /**
+     * @brief 输入编码为位掩码
+     * @param input 输入
+     * @return quint8 位掩码
+     */
+    static quint8 encode(const InputFrame& input);
+
+    /**
+     * @brief 位掩码解码为输入
+     * @param mask 位掩码
+     * @return InputFrame 输入
+     */
+    static InputFrame decode(quint8 mask);
+
+    /**
+     * @brief 计算关卡文件内容的SHA-1
+     * @param filePath 关卡文件路径
+     * @return QByteArray 哈希，文件无法读取时为空
+     */
+    static QByteArray hashLevelFile(const QString& filePath);
+
+    /**
+     * @brief 无界面回放基准测试：不创建窗口，尽可能快地重复回放
+     * @param replay 录像
+     * @param iterations 回放次数
+     * @return ReplayBenchResult 测试结果
+     */
+    static ReplayBenchResult runBenchmark(const Replay& replay, int iterations);
+
+    /**
+     * @brief 无界面基准测试：对给定关卡重复执行一段输入序列（用于合成关卡）
+     *
+     * 计时回放关闭阶段计时，之后单独回放一轮统计各阶段耗时，总耗时不含
+     * 阶段计时器本身的开销。
+     * @param levelData 关卡数据
+     * @param frames 每tick输入
+     * @param iterations 回放次数
+     * @return ReplayBenchResult 测试结果（不含录像校验项）
+     */
+    static ReplayBenchResult runBenchmark(LevelData& levelData, const QVector<InputFrame>& frames,
+                                          int iterations);
+
+    /**
+     * @brief 生成录像默认保存路径（data/replays/replay_时间戳.ljr）
+     * @return QString 文件路径
+     */
+    static QString defaultSavePath();
+
+private:
+    QString level_path;             ///< 关卡文件路径
+    QByteArray level_hash;          ///< 关卡文件SHA-1
+    QVector<quint8> input_masks;    ///< 每tick输入位掩码
+    quint64 final_state_hash;       ///< 结束时的状态哈希
+    bool has_final_state_hash;      ///< 是否记录了结束状态
+};
+
+#endif // REPLAY_H
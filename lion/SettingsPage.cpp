@@ -11,6 +11,7 @@
 #include <QMessageBox>
 #include <QScrollArea>
 #include "AudioController.h"
+#include "TextureCache.h"
 /**
  * @brief 构造设置页面窗口并初始化界面
  * @param parent 父窗口指针
@@ -35,7 +36,7 @@ void SettingsPage::ui_load() {
     this->resize(1280, 720);
     
     // 设置背景图片
-    QPixmap back(":/images/setting_page.png");
+    QPixmap back = TextureCache::getInstance().pixmap(":/images/setting_page.png");
     QPixmap scaledback = back.scaled(this->size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
     QPalette palette;
     palette.setBrush(QPalette::Window, scaledback);
@@ -216,7 +217,7 @@ void SettingsPage::ui_load() {
     QHBoxLayout* buttonLayout = new QHBoxLayout();
     
     // 使用与菜单相同的按钮样式
-    QPixmap buttonImg(":/ui/Picture/button_y.png");
+    QPixmap buttonImg = TextureCache::getInstance().pixmap(":/ui/Picture/button_y.png");
     QPixmap scaledButtonImg = buttonImg.scaled(200, 100, Qt::KeepAspectRatio, Qt::SmoothTransformation);
     
     // 返回按钮
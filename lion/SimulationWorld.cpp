@@ -0,0 +1,949 @@
+/**
+ * @file SimulationWorld.cpp
+ * @brief 与界面无关的确定性游戏模拟核心实现
+ * @author 开发团队
+ * @date 2025-11-24
+ */
+
+#include "SimulationWorld.h"
+#include "LogCategories.h"
+#include <QDebug>
+#include <QHash>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+
+SimulationWorld::SimulationWorld()
+    : level_data(nullptr)
+    , activity_index(CHUNK_TILES * B0)
+    , activity_stamp(0)
+    , collected_count(0)
+    , is_in_water(false)
+    , finished(false)
+    , tick_counter(0)
+    , stage_timing_enabled(false)
+{
+    resetStageTimes();
+    pl.setSolidRects(&player_solids);
+}
+
+void SimulationWorld::loadLevel(LevelData* levelData)
+{
+    level_data = levelData;
+
+    // 碰撞网格由关卡数据持有并随网格同步更新，这里只需挂接
+    pl.setCollisionGrid(level_data ? &level_data->getCollisionGrid() : nullptr);
+
+    // 元素在关卡运行期间不增删，组件与静态索引只需在加载时建立一次
+    if (level_data) {
+        store.build(level_data->getGameElements());
+    } else {
+        store.clear();
+    }
+    collected_flags.resize(store.collect_slot_count);
+    buildElementIndex();
+    buildTriggerGraph();
+
+    reset();
+}
+
+void SimulationWorld::reset()
+{
+    collected_flags.fill(false);
+    collected_count = 0;
+    projectiles.clear();
+    is_in_water = false;
+    finished = false;
+    tick_counter = 0;
+
+    // 玩家回到初始运动状态，保证同一输入序列的结果可复现
+    pl.resetMotion();
+    pl.resetMoveSpeed();
+    pl.resetKeyStates();
+
+    if (level_data) {
+        QPointF startPos = level_data->getPlayerStartPosition();
+        pl.setPixelPos(static_cast<int>(startPos.x()), static_cast<int>(startPos.y()));
+        level_data->resetObjectiveProgress();
+    }
+    prev_player_pos = pl.pos();
+
+    initializeMovingPlatforms();
+    buildActivityIndex();
+    refreshActiveSet();
+    updatePlatformBroadphase();
+    resetTriggers();
+    player_solids.clear();
+}
+
+StepResult SimulationWorld::step(const InputFrame& input)
+{
+    StepResult result;
+    if (!level_data || finished) return result;
+
+    // 分阶段计时：每个阶段结束时把耗时累加到对应槽位
+    QElapsedTimer stageTimer;
+    if (stage_timing_enabled) stageTimer.start();
+    auto endStage = [&](Stage stage) {
+        if (!stage_timing_enabled) return;
+        stage_time_ns[stage] += stageTimer.nsecsElapsed();
+        stageTimer.start();
+    };
+
+    // 只模拟玩家附近的平台与箭机关
+    refreshActiveSet();
+
+    // 记录上一tick的状态，供渲染插值使用
+    prev_player_pos = pl.pos();
+    for (int index : active_platforms) {
+        auto& platform = moving_platforms[index];
+        platform.prev_pos = platform.current_pos;
+    }
+
+    // 应用输入：起跳条件与原按键处理一致
+    pl.setLeftPressed(input.left);
+    pl.setRightPressed(input.right);
+    if (input.jump && !pl.isJump && (pl.onGround || pl.onMovingPlatform)) {
+        pl.jump();
+        result.jumped = true;
+    }
+    if (input.dash) {
+        pl.startDash();
+    }
+
+    tick_counter++;
+
+    updateMovingPlatforms();
+    endStage(StagePlatforms);
+
+    // 保存玩家移动前的位置
+    const Fx::Fixed prev_x = pl.fx;
+    const Fx::Fixed prev_y = pl.fy;
+
+    // 玩家对网格、关闭的门与平台顶面做连续碰撞
+    collectPlayerSolids();
+    pl.update();
+    endStage(StagePlayer);
+
+    // 检查移动平台碰撞（在玩家更新后）
+    checkMovingPlatformCollisions();
+
+    // 处理玩家跟随移动平台（在碰撞检测后，独立处理）
+    handlePlatformFollowing();
+    endStage(StagePlatformCollision);
+
+    // 检查门碰撞，如果与关闭的门碰撞则恢复到之前的位置
+    if (checkDoorCollision(pl.rect())) {
+        pl.fx = prev_x;
+        pl.fy = prev_y;
+    }
+    endStage(StageDoors);
+
+    fireArrowTraps();
+    endStage(StageTraps);
+    const bool hitByArrow = updateProjectiles();
+    endStage(StageProjectiles);
+    if (hitByArrow) {
+        result.player_died = true;
+        finished = true;
+        return result;
+    }
+
+    checkSwitchCollisions();
+    endStage(StageSwitches);
+
+    checkGameElementCollisions(result);
+    endStage(StageElements);
+    return result;
+}
+
+bool SimulationWorld::isCollected(int elementIndex) const
+{
+    const CollectibleComponent* collectible = store.collectibles.find(elementIndex);
+    return collectible && collected_flags.testBit(collectible->slot);
+}
+
+bool SimulationWorld::isSolid(int col, int row) const
+{
+    return level_data && level_data->getCollisionGrid().isSolid(col, row);
+}
+
+bool SimulationWorld::isDoorClosed(int elementIndex) const
+{
+    const TriggerComponent* door = store.triggers.find(elementIndex);
+    return !door || !door->active;
+}
+
+void SimulationWorld::buildElementIndex()
+{
+    element_index = SpatialHash(B0);
+
+    for (EntityId entity = 0; entity < store.entityCount(); ++entity) {
+        // 移动平台位置每tick变化，由平台粗筛处理
+        if (store.movers.has(entity)) continue;
+        element_index.insert(entity, store.rectOf(entity));
+    }
+}
+
+void SimulationWorld::updatePlatformBroadphase()
+{
+    for (int i : active_platforms) {
+        const auto& platform = moving_platforms[i];
+        platform_broadphase.update(i, QRectF(platform.currentPos(), store.rectOf(platform.element_index).size()));
+    }
+    platform_broadphase.sort();
+}
+
+void SimulationWorld::buildActivityIndex()
+{
+    activity_index.clear();
+
+    // 平台按整个行程登记，无论当前走到哪里都能被查到
+    for (const auto& platform : moving_platforms) {
+        activity_index.insert(platform.element_index,
+                              platform.path.travelBounds(store.rectOf(platform.element_index).size()));
+    }
+
+    for (int i = 0; i < store.emitters.size(); ++i) {
+        const EntityId entity = store.emitters.entityAt(i);
+        activity_index.insert(entity, store.rectOf(entity));
+    }
+}
+
+QRectF SimulationWorld::getActiveRegion() const
+{
+    const QPointF center = pl.rect().center();
+    return QRectF(center.x() - 1.5 * XSIZE, center.y() - 1.5 * YSIZE, 3.0 * XSIZE, 3.0 * YSIZE);
+}
+
+void SimulationWorld::refreshActiveSet()
+{
+    active_platforms.swap(previous_platforms);
+    active_platforms.clear();
+    active_traps.clear();
+    if (!level_data) return;
+    ++activity_stamp;
+
+    // 查询结果按元素索引升序，保证处理顺序与全量遍历一致
+    const QRectF region = getActiveRegion();
+    activity_index.query(region, activity_hits);
+    for (int i : activity_hits) {
+        // 平台状态与移动组件同序
+        const int platform = store.movers.indexOf(i);
+        if (platform >= 0) {
+            auto& state = moving_platforms[platform];
+            if (state.active_stamp != activity_stamp - 1) {
+                // 醒来：直接求出当前tick的位置，不从休眠时的位置插值
+                state.current_pos = state.path.positionAt(state.clockAt(tick_counter));
+                state.prev_pos = state.current_pos;
+            }
+            state.active_stamp = activity_stamp;
+            active_platforms.append(platform);
+        } else {
+            active_traps.append(i);
+        }
+    }
+
+    // 离开活动区域的平台休眠，不再参与粗筛
+    for (int platform : previous_platforms) {
+        if (moving_platforms[platform].active_stamp != activity_stamp) {
+            platform_broadphase.remove(platform);
+        }
+    }
+
+    // 不足一屏的关卡按一屏计算，与单屏版本的出界判断一致
+    const QRectF levelRect(0, 0, qMax(level_data->getWidth() * B0, XSIZE),
+                           qMax(level_data->getHeight() * B0, YSIZE));
+    projectile_bounds = levelRect.adjusted(-50, -50, 50, 50).intersected(region);
+}
+
+quint64 SimulationWorld::computeStateHash() const
+{
+    // FNV-1a 64位，逐字节混入各状态字段；浮点数按位参与，保证逐位一致才算匹配
+    quint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    auto mixInt = [&mix](qint64 value) { mix(&value, sizeof(value)); };
+    auto mixReal = [&mix](double value) { mix(&value, sizeof(value)); };
+
+    mixInt(tick_counter);
+    mixInt(finished);
+    mixInt(is_in_water);
+
+    mixInt(pl.fx);
+    mixInt(pl.fy);
+    mixInt(pl.v0);
+    mixInt(pl.isJump);
+    mixInt(pl.isRight);
+    mixInt(pl.onGround);
+    mixInt(pl.onMovingPlatform);
+    mixInt(pl.currentPlatformIndex);
+    mixInt(pl.getIsDashing());
+
+    for (int i = 0; i < projectiles.highWater(); ++i) {
+        if (!projectiles.isActive(i)) continue;
+        mixInt(i);
+        mixReal(projectiles.posX(i));
+        mixReal(projectiles.posY(i));
+        mixReal(projectiles.velX(i));
+        mixReal(projectiles.velY(i));
+    }
+
+    for (const auto& platform : moving_platforms) {
+        mixInt(platform.current_pos.x);
+        mixInt(platform.current_pos.y);
+        mixInt(platform.running);
+        mixInt(platform.clock_offset);
+    }
+
+    for (int i = 0; i < store.triggers.size(); ++i) {
+        mixInt(store.triggers.at(i).active);
+    }
+    for (int i = 0; i < trigger_graph.nodeCount(); ++i) {
+        mixInt(trigger_graph.value(i));
+    }
+    mixInt(trigger_graph.pendingEventCount());
+
+    mixInt(collected_count);
+    if (level_data) {
+        for (const auto& objective : level_data->getObjectives()) {
+            mixInt(objective.current_count);
+        }
+    }
+    return hash;
+}
+
+void SimulationWorld::resetStageTimes()
+{
+    for (int i = 0; i < StageCount; ++i) {
+        stage_time_ns[i] = 0;
+    }
+}
+
+const char* SimulationWorld::stageName(Stage stage)
+{
+    switch (stage) {
+    case StagePlatforms:         return "platforms";
+    case StagePlayer:            return "player";
+    case StagePlatformCollision: return "plat_coll";
+    case StageDoors:             return "doors";
+    case StageTraps:             return "traps";
+    case StageProjectiles:       return "projectiles";
+    case StageSwitches:          return "switches";
+    case StageElements:          return "elements";
+    default:                     return "unknown";
+    }
+}
+
+// === 箭矢 ===
+
+void SimulationWorld::fireArrowTraps()
+{
+    for (EntityId entity : active_traps) {
+        const EmitterComponent* emitter = store.emitters.find(entity);
+        if (!emitter || !emitter->enabled || tick_counter % emitter->interval != 0) continue; // 默认每1秒发射一次
+
+        // 方向、速度与箭矢大小已在构建组件时算好
+        if (projectiles.spawn(emitter->origin.x(), emitter->origin.y(),
+                              emitter->vx, emitter->vy, emitter->width, emitter->height) < 0) {
+            LJ_HOT_DEBUG(lcSim) << "箭矢池已满，丢弃新箭矢";
+        }
+    }
+}
+
+bool SimulationWorld::updateProjectiles()
+{
+    if (projectiles.isEmpty()) return false;
+
+    // 批量积分与出界判断
+    projectiles.integrate(projectile_bounds.left(), projectile_bounds.top(),
+                          projectile_bounds.right(), projectile_bounds.bottom());
+
+    const QRectF playerRect = pl.rect();
+    for (int i = 0; i < projectiles.highWater(); ++i) {
+        if (!projectiles.isActive(i)) continue;
+
+        QRectF arrowRect(projectiles.posX(i), projectiles.posY(i),
+                         projectiles.sizeX(i), projectiles.sizeY(i));
+
+        // 检查与玩家的碰撞
+        if (arrowRect.intersects(playerRect)) {
+            return true;
+        }
+
+        // 检查箭矢覆盖的所有网格是否与实心方块碰撞
+        if (overlapsSolid(arrowRect)) {
+            projectiles.kill(i);
+        }
+    }
+    // 回收无效箭矢的槽位
+    projectiles.reclaim();
+    return false;
+}
+
+bool SimulationWorld::overlapsSolid(const QRectF& rect) const
+{
+    int leftCol = static_cast<int>(rect.left()) / B0;
+    int rightCol = static_cast<int>(rect.left() + rect.width()) / B0;
+    int topRow = static_cast<int>(rect.top()) / B0;
+    int bottomRow = static_cast<int>(rect.top() + rect.height()) / B0;
+
+    // 确保坐标在地图范围内
+    if (!level_data) return false;
+    const CollisionGrid& grid = level_data->getCollisionGrid();
+    leftCol = qMax(0, qMin(leftCol, grid.getWidth() - 1));
+    rightCol = qMax(0, qMin(rightCol, grid.getWidth() - 1));
+    topRow = qMax(0, qMin(topRow, grid.getHeight() - 1));
+    bottomRow = qMax(0, qMin(bottomRow, grid.getHeight() - 1));
+
+    return grid.anySolidInRect(leftCol, topRow, rightCol, bottomRow);
+}
+
+// === 游戏元素 ===
+
+void SimulationWorld::checkGameElementCollisions(StepResult& result)
+{
+    if (!level_data) return;
+
+    const QRectF playerRect = pl.rect();
+    bool touchedSlowZone = false;
+
+    // 只检查玩家所在格子中的实体，按实体顺序处理；只看危险区域与可收集物组件
+    element_index.query(playerRect, element_hits);
+    for (EntityId entity : element_hits) {
+        if (!playerRect.intersects(store.rectOf(entity))) continue;
+
+        if (const HazardComponent* hazard = store.hazards.find(entity)) {
+            if (hazard->effect == HazardEffect::Lethal) {
+                result.player_died = true;
+                finished = true;
+                return;
+            }
+            touchedSlowZone = true;
+            if (!is_in_water) {
+                is_in_water = true;
+                pl.setMoveSpeedScale(hazard->speed_scale);
+            }
+        }
+
+        if (const CollectibleComponent* collectible = store.collectibles.find(entity)) {
+            if (collectible->kind == CollectibleKind::Exit) {
+                if (!canCompleteLevel()) {
+                    // 未满足通关条件，由渲染层显示提示
+                    result.exit_blocked = true;
+                } else if (!collected_flags.testBit(collectible->slot)) {
+                    collectItem(entity, result);
+                    result.level_completed = true;
+                    finished = true;
+                    return;
+                }
+            } else if (!collected_flags.testBit(collectible->slot)) {
+                collectItem(entity, result);
+            }
+        }
+    }
+
+    // 离开减速区域时恢复
+    if (!touchedSlowZone && is_in_water) {
+        is_in_water = false;
+        pl.setMoveSpeedScale(1.0);
+    }
+}
+
+bool SimulationWorld::canCompleteLevel() const
+{
+    const auto& objectives = level_data->getObjectives();
+    if (objectives.isEmpty()) {
+        // 没有设置目标，直接允许通关（向后兼容）
+        return true;
+    }
+
+    // 有青菜收集目标时必须完成才能通关
+    bool hasVegetableObjective = false;
+    for (const auto& obj : objectives) {
+        if (obj.objective_type == "collect_vegetables") {
+            hasVegetableObjective = true;
+            if (!obj.isCompleted()) {
+                return false;
+            }
+        }
+    }
+
+    // 没有青菜收集目标，检查所有其他目标是否完成
+    return hasVegetableObjective || level_data->areAllObjectivesCompleted();
+}
+
+void SimulationWorld::collectItem(int elementIndex, StepResult& result)
+{
+    const CollectibleComponent* collectible = store.collectibles.find(elementIndex);
+    if (!collectible) return;
+
+    collected_flags.setBit(collectible->slot);
+    collected_count++;
+    result.collected_elements.append(elementIndex);
+
+    // 更新关卡目标进度
+    level_data->updateObjectiveProgress(collectible->objective, 1);
+    result.objectives_changed = true;
+    LJ_HOT_DEBUG(lcSim) << (collectible->kind == CollectibleKind::Exit ? "到达终点！" : "收集到青菜！");
+}
+
+// === 移动平台 ===
+
+void SimulationWorld::initializeMovingPlatforms()
+{
+    moving_platforms.clear();
+    platform_broadphase.clear();
+    active_platforms.clear();
+    previous_platforms.clear();
+    activity_stamp = 1;     // 平台的 active_stamp 初始为0，首次刷新时全部视为醒来
+
+    if (!level_data) return;
+
+    // 平台状态与移动组件一一对应、顺序相同
+    const auto& elements = level_data->getGameElements();
+    moving_platforms.reserve(store.movers.size());
+    for (int i = 0; i < store.movers.size(); ++i) {
+        const EntityId entity = store.movers.entityAt(i);
+        const auto& element = elements[entity];
+
+        MovingPlatformState platform;
+        platform.element_index = entity;
+        // 路径、速度与曲线已在关卡加载时解析，只在此处转换为定点
+        platform.path.build(element.position, element.platform);
+        platform.current_pos = platform.path.positionAt(tick_counter);
+        platform.prev_pos = platform.current_pos;
+
+        moving_platforms.append(platform);
+    }
+}
+
+void SimulationWorld::updateMovingPlatforms()
+{
+    // 位置是路径时钟的闭式函数，休眠与暂停期间不需要推进
+    for (int index : active_platforms) {
+        auto& platform = moving_platforms[index];
+        if (platform.path.isStatic() || !platform.running) continue;
+        platform.current_pos = platform.path.positionAt(platform.clockAt(tick_counter));
+    }
+
+    if (!active_platforms.isEmpty()) {
+        updatePlatformBroadphase();
+    }
+}
+
+void SimulationWorld::collectPlayerSolids()
+{
+    player_solids.clear();
+
+    // 接入触发图且关闭的门四面阻挡
+    for (int i = 0; i < store.triggers.size(); ++i) {
+        const TriggerComponent& trigger = store.triggers.at(i);
+        if (trigger.role != TriggerRole::Door || trigger.node < 0 || trigger.active) continue;
+        SolidRect solid;
+        solid.rect = Fx::Rect::fromRectF(store.rectOf(store.triggers.entityAt(i)));
+        player_solids.append(solid);
+    }
+
+    // 移动平台只能从上方落上；只取本tick扫掠可能到达范围内的平台
+    const qreal reach = B0 + Fx::toReal(qAbs(pl.v0) + player::GRAVITY);
+    platform_broadphase.query(pl.rect().adjusted(-reach, -reach, reach, reach), platform_hits);
+    for (int index : platform_hits) {
+        const auto& platform = moving_platforms[index];
+        SolidRect solid;
+        const QSizeF size = store.rectOf(platform.element_index).size();
+        solid.rect = Fx::Rect::fromPosSize(platform.current_pos, Fx::fromReal(size.width()),
+                                           Fx::fromReal(size.height()));
+        solid.one_way = true;
+        player_solids.append(solid);
+    }
+}
+
+void SimulationWorld::checkMovingPlatformCollisions()
+{
+    if (!level_data) return;
+
+    bool isSupported = false; // 标记玩家本帧是否被任何平面支撑
+    const Fx::Fixed vertical_tolerance = Fx::fromInt(5);
+    const Fx::Fixed playerW = Fx::fromInt(pl.w);
+    const Fx::Fixed playerH = Fx::fromInt(pl.h);
+    const Fx::Fixed playerBottom = pl.fy + playerH;
+
+    // 默认玩家不在移动平台上，除非检测到
+    pl.onMovingPlatform = false;
+
+    // 只检查顶面可能落在玩家脚下容差范围内的平台
+    QRectF footProbe(Fx::toReal(pl.fx), Fx::toReal(playerBottom - vertical_tolerance),
+                     pl.w, Fx::toReal(vertical_tolerance));
+    platform_broadphase.query(footProbe, platform_hits);
+    for (int i : platform_hits) {
+        const auto& platform = moving_platforms[i];
+        const Fx::Fixed platformLeft = platform.current_pos.x;
+        const Fx::Fixed platformRight = platformLeft + Fx::fromReal(store.rectOf(platform.element_index).width());
+        const Fx::Fixed platformTop = platform.current_pos.y;
+
+        // 只关心玩家是否在平台上方，并且即将或正在接触
+        bool isHorizontallyAligned = pl.fx + playerW > platformLeft && pl.fx < platformRight;
+        bool isVerticallyClose = playerBottom >= platformTop && playerBottom <= platformTop + vertical_tolerance;
+
+        if (isHorizontallyAligned && isVerticallyClose) {
+            // 玩家在平台上方
+            pl.fy = platformTop - playerH; // 精确地将玩家放在平台表面
+
+            // 只有当玩家向下运动或静止时才重置跳跃状态，保证跳跃意图不被打断
+            if (pl.v0 >= 0) {
+                pl.v0 = 0;
+                pl.isJump = false;
+            }
+
+            isSupported = true;
+            pl.onMovingPlatform = true;
+            pl.onGround = true; // 强制设置onGround为true，确保可以跳跃
+
+            pl.resetAirDash(); // 在移动平台落地时，重置空中冲刺
+
+            // 如果这是玩家新接触的平台，或者平台索引变了，则更新相对位置
+            if (pl.currentPlatformIndex != i) {
+                pl.currentPlatformIndex = i;
+                pl.platformRelativeX = pl.fx - platform.current_pos.x;
+                pl.platformRelativeY = pl.fy - (platform.current_pos.y - playerH);
+            }
+
+            // 既然已经找到了支撑平台，就没必要再检查其他移动平台了
+            break;
+        }
+    }
+
+    // 如果没有被任何移动平台支撑，则检查静态地面
+    if (!isSupported) {
+        pl.currentPlatformIndex = -1;
+        if (pl.is_ground()) {
+            isSupported = true;
+        }
+    }
+
+    pl.onGround = isSupported;
+}
+
+void SimulationWorld::handlePlatformFollowing()
+{
+    // 如果玩家不在移动平台上，重置相关状态
+    if (!pl.onMovingPlatform) {
+        pl.currentPlatformIndex = -1;
+        pl.platformRelativeX = 0;
+        pl.platformRelativeY = 0;
+        return;
+    }
+
+    if (pl.currentPlatformIndex < 0 || pl.currentPlatformIndex >= moving_platforms.size()) return;
+
+    const auto& platform = moving_platforms[pl.currentPlatformIndex];
+    const QRectF& platformRect = store.rectOf(platform.element_index);
+    const Fx::Fixed playerW = Fx::fromInt(pl.w);
+    const Fx::Fixed playerH = Fx::fromInt(pl.h);
+
+    bool isActivelyMoving = pl.getLeftPressed() || pl.getRightPressed();
+    bool isActivelyJumping = pl.isJump && pl.v0 < 0; // 正在向上跳跃
+
+    // 处理水平跟随（定点运算，慢速平台也不会因取整产生抖动或漂移）
+    if (isActivelyMoving) {
+        // 玩家主动移动时，更新相对位置
+        pl.platformRelativeX = pl.fx - platform.current_pos.x;
+    } else {
+        // 玩家没有主动移动时，按平台位置和相对位置计算玩家的绝对位置
+        const Fx::Fixed newPlayerX = platform.current_pos.x + pl.platformRelativeX;
+
+        const Fx::Fixed platformLeft = platform.current_pos.x;
+        const Fx::Fixed platformRight = platformLeft + Fx::fromReal(platformRect.width());
+
+        // 与平台仍有重叠则跟随平台，否则停止跟随
+        if (newPlayerX + playerW > platformLeft && newPlayerX < platformRight) {
+            pl.fx = newPlayerX;
+        } else {
+            pl.onMovingPlatform = false;
+            pl.currentPlatformIndex = -1;
+            pl.platformRelativeX = 0;
+            pl.platformRelativeY = 0;
+            return;
+        }
+    }
+
+    // 处理垂直跟随：与水平跟随逻辑保持一致
+    if (isActivelyJumping) {
+        pl.platformRelativeY = pl.fy - (platform.current_pos.y - playerH);
+    } else {
+        const Fx::Fixed newPlayerY = (platform.current_pos.y - playerH) + pl.platformRelativeY;
+
+        const Fx::Fixed platformTop = platform.current_pos.y;
+        const Fx::Fixed platformBottom = platformTop + Fx::fromReal(platformRect.height());
+
+        if (newPlayerY + playerH > platformTop && newPlayerY < platformBottom) {
+            pl.fy = newPlayerY;
+        } else {
+            pl.onMovingPlatform = false;
+            pl.currentPlatformIndex = -1;
+            pl.platformRelativeX = 0;
+            pl.platformRelativeY = 0;
+        }
+    }
+}
+
+// === 开关门 ===
+
+void SimulationWorld::buildTriggerGraph()
+{
+    trigger_graph.clear();
+    for (int i = 0; i < store.triggers.size(); ++i) {
+        store.triggers.at(i).node = -1;
+    }
+
+    if (!level_data) return;
+
+    const auto& elements = level_data->getGameElements();
+
+    // 每个开关一个源节点；同名（switch_id相同）的多个开关以或节点作为该名字
+    QHash<QString, int> nodeOfName;
+    QHash<QString, QVector<int>> sourcesOfName;
+    QStringList switchNames;        // 按首次出现的顺序建立或节点，节点编号与哈希顺序无关
+    for (int i = 0; i < store.triggers.size(); ++i) {
+        TriggerComponent& trigger = store.triggers.at(i);
+        if (trigger.role != TriggerRole::Switch) continue;
+        trigger.node = trigger_graph.addNode(TriggerNodeType::Source);
+
+        const QString name = elements[store.triggers.entityAt(i)].trigger.name;
+        if (name.isEmpty()) continue;
+        if (!sourcesOfName.contains(name)) switchNames.append(name);
+        sourcesOfName[name].append(trigger.node);
+    }
+    for (const QString& name : switchNames) {
+        const QVector<int>& sources = sourcesOfName[name];
+        int node = sources.first();
+        if (sources.size() > 1) {
+            node = trigger_graph.addNode(TriggerNodeType::Or);
+            for (int source : sources) trigger_graph.connect(source, node);
+        }
+        nodeOfName.insert(name, node);
+    }
+
+    // 逻辑节点：先建立全部节点，之后再连线，输入可以引用定义在后面的节点
+    QVector<QPair<int, QJsonArray>> nodeInputs;
+    for (const QJsonValue& value : level_data->getLogicNodes()) {
+        const QJsonObject def = value.toObject();
+        const QString id = def.value("id").toString();
+        if (id.isEmpty() || nodeOfName.contains(id)) {
+            qCDebug(lcLevel) << "逻辑节点id为空或重复，已忽略：" << id;
+            continue;
+        }
+
+        const QString type = def.value("type").toString();
+        int node = -1;
+        if (type == "and") {
+            node = trigger_graph.addNode(TriggerNodeType::And);
+        } else if (type == "or") {
+            node = trigger_graph.addNode(TriggerNodeType::Or);
+        } else if (type == "toggle") {
+            node = trigger_graph.addNode(TriggerNodeType::Toggle);
+        } else if (type == "delay") {
+            node = trigger_graph.addNode(TriggerNodeType::Delay, def.value("ticks").toInt(0));
+        } else if (type == "timer") {
+            const int period = def.value("period").toInt(120);
+            node = trigger_graph.addNode(TriggerNodeType::Timer, period, def.value("on").toInt(period / 2));
+        } else {
+            qCDebug(lcLevel) << "未知的逻辑节点类型，已忽略：" << id << type;
+            continue;
+        }
+        nodeOfName.insert(id, node);
+        nodeInputs.append(qMakePair(node, def.value("inputs").toArray()));
+    }
+
+    auto resolve = [&nodeOfName](const QString& name) {
+        const int node = nodeOfName.value(name, -1);
+        if (node < 0) {
+            qCDebug(lcLevel) << "触发图引用了不存在的节点：" << name;
+        }
+        return node;
+    };
+    for (const auto& inputs : nodeInputs) {
+        for (const QJsonValue& input : inputs.second) {
+            const int from = resolve(input.toString());
+            if (from >= 0) trigger_graph.connect(from, inputs.first);
+        }
+    }
+
+    // 旧的开关配对：每个配对id对应的第一个门；缺省id为元素自身索引
+    auto pairIdOf = [&elements](EntityId entity) {
+        const PairingProps& pairing = elements[entity].pairing;
+        return pairing.has_pair_id ? pairing.pair_id : entity;
+    };
+    QHash<int, EntityId> firstDoorOfId;
+    for (int i = 0; i < store.triggers.size(); ++i) {
+        if (store.triggers.at(i).role != TriggerRole::Door) continue;
+        const EntityId door = store.triggers.entityAt(i);
+        const int id = pairIdOf(door);
+        if (!firstDoorOfId.contains(id)) firstDoorOfId.insert(id, door);
+    }
+
+    // 每个开关配对到满足条件的索引最小的门：配对id相同，或由paired_door直接指定
+    QHash<EntityId, QVector<int>> sourcesOfDoor;
+    for (int i = 0; i < store.triggers.size(); ++i) {
+        if (store.triggers.at(i).role != TriggerRole::Switch) continue;
+        const EntityId switchEntity = store.triggers.entityAt(i);
+
+        EntityId door = firstDoorOfId.value(pairIdOf(switchEntity), -1);
+        const EntityId pairedDoor = elements[switchEntity].pairing.paired_door;
+        const TriggerComponent* pairedTrigger = store.triggers.find(pairedDoor);
+        if (pairedTrigger && pairedTrigger->role == TriggerRole::Door && (door < 0 || pairedDoor < door)) {
+            door = pairedDoor;
+        }
+        if (door >= 0) {
+            sourcesOfDoor[door].append(store.triggers.at(i).node);
+        }
+    }
+
+    // 受控对象：input 属性优先；门没有 input 时由全部配对开关的与门驱动
+    auto inputOf = [&elements](EntityId entity) {
+        return elements[entity].trigger.input;
+    };
+    for (int i = 0; i < store.triggers.size(); ++i) {
+        TriggerComponent& trigger = store.triggers.at(i);
+        if (trigger.role != TriggerRole::Door) continue;
+        const EntityId door = store.triggers.entityAt(i);
+
+        const QString input = inputOf(door);
+        if (!input.isEmpty()) {
+            trigger.node = resolve(input);
+        } else if (sourcesOfDoor.contains(door)) {
+            const QVector<int>& sources = sourcesOfDoor[door];
+            trigger.node = sources.first();
+            if (sources.size() > 1) {
+                trigger.node = trigger_graph.addNode(TriggerNodeType::And);
+                for (int source : sources) trigger_graph.connect(source, trigger.node);
+            }
+        }
+        if (trigger.node >= 0) {
+            trigger_graph.addSink(trigger.node, TriggerSinkKind::Door, door);
+        }
+    }
+    for (int i = 0; i < store.movers.size(); ++i) {
+        const EntityId entity = store.movers.entityAt(i);
+        const QString input = inputOf(entity);
+        if (input.isEmpty()) continue;
+        trigger_graph.addSink(resolve(input), TriggerSinkKind::Platform, entity);
+    }
+    for (int i = 0; i < store.emitters.size(); ++i) {
+        const EntityId entity = store.emitters.entityAt(i);
+        const QString input = inputOf(entity);
+        if (input.isEmpty()) continue;
+        trigger_graph.addSink(resolve(input), TriggerSinkKind::Trap, entity);
+    }
+
+    if (!trigger_graph.compile()) {
+        qCDebug(lcLevel) << "触发图存在环，环上的节点及其下游不再响应输入";
+    }
+}
+
+void SimulationWorld::resetTriggers()
+{
+    pressed_plates.clear();
+    for (int i = 0; i < store.triggers.size(); ++i) {
+        store.triggers.at(i).active = false;
+    }
+    for (int i = 0; i < store.emitters.size(); ++i) {
+        store.emitters.at(i).enabled = true;
+    }
+
+    // 重置后的输出变化包含全部受控对象的初始值
+    trigger_graph.reset();
+    applyTriggerChanges();
+}
+
+void SimulationWorld::checkSwitchCollisions()
+{
+    if (trigger_graph.isEmpty()) return;
+
+    const QRectF playerRect = pl.rect();
+
+    // 压力板只在被踩住时为真：只检查当前踩住的几块，离开的复位
+    int kept = 0;
+    for (EntityId plate : pressed_plates) {
+        if (playerRect.intersects(store.rectOf(plate))) {
+            pressed_plates[kept++] = plate;
+            continue;
+        }
+        TriggerComponent* trigger = store.triggers.find(plate);
+        trigger->active = false;
+        trigger_graph.setSource(trigger->node, false);
+    }
+    pressed_plates.resize(kept);
+
+    element_index.query(playerRect, element_hits);
+    for (EntityId entity : element_hits) {
+        TriggerComponent* trigger = store.triggers.find(entity);
+        if (!trigger || trigger->role != TriggerRole::Switch || trigger->active) continue;
+
+        if (playerRect.intersects(store.rectOf(entity))) {
+            trigger->active = true;
+            trigger_graph.setSource(trigger->node, true);
+            if (trigger->momentary) {
+                pressed_plates.append(entity);
+            }
+            LJ_HOT_DEBUG(lcSim) << "Switch activated!";
+        }
+    }
+
+    // 没有开关变化也没有到期事件时，推进只比较一次事件堆顶
+    if (trigger_graph.advance(tick_counter)) {
+        applyTriggerChanges();
+    }
+}
+
+void SimulationWorld::applyTriggerChanges()
+{
+    for (const TriggerSinkChange& change : trigger_graph.sinkChanges()) {
+        switch (change.kind) {
+        case TriggerSinkKind::Door:
+            store.triggers.find(change.entity)->active = change.value;
+            LJ_HOT_DEBUG(lcSim) << (change.value ? "Door opened." : "Door closed.");
+            break;
+        case TriggerSinkKind::Platform: {
+            // 平台状态与移动组件同序；暂停时冻结路径时钟，恢复时把暂停时长计入偏移
+            auto& platform = moving_platforms[store.movers.indexOf(change.entity)];
+            if (platform.running == change.value) break;
+            if (change.value) {
+                platform.clock_offset += tick_counter - platform.paused_tick;
+            } else {
+                platform.paused_tick = tick_counter;
+            }
+            platform.running = change.value;
+            break;
+        }
+        case TriggerSinkKind::Trap:
+            store.emitters.find(change.entity)->enabled = change.value;
+            break;
+        }
+    }
+}
+
+bool SimulationWorld::checkDoorCollision(const QRectF& playerRect) const
+{
+    if (store.triggers.isEmpty()) return false;
+
+    element_index.query(playerRect, element_hits);
+    for (EntityId entity : element_hits) {
+        // 只检查接入触发图且关闭的门
+        const TriggerComponent* trigger = store.triggers.find(entity);
+        if (!trigger || trigger->role != TriggerRole::Door || trigger->node < 0 || trigger->active) continue;
+
+        if (playerRect.intersects(store.rectOf(entity))) {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,399 @@
+/**
+ * @file SimulationWorld.h
+ * @brief 与界面无关的确定性游戏模拟核心
+ * @author 开发团队
+ * @date 2025-11-24
+ * @version 1.0.0
+ */
+
+#ifndef SIMULATIONWORLD_H
+#define SIMULATIONWORLD_H
+
+#include <QVector>
+#include <QBitArray>
+#include <QPointF>
+#include <QRectF>
+#include "Config.h"
+#include "LevelData.h"
+#include "player.h"
+#include "FixedPoint.h"
+#include "SpatialHash.h"
+#include "SweepAndPrune.h"
+#include "PlatformPath.h"
+#include "ElementStore.h"
+#include "TriggerGraph.h"
+#include "ProjectilePool.h"
+
+/**
+ * @struct InputFrame
+ * @brief 单个tick的玩家输入
+ *
+ * 移动键为按住状态，跳跃与冲刺为边沿触发（本tick内按下过一次即为true）。
+ */
+struct InputFrame {
+    bool left = false;      ///< A 键按住
+    bool right = false;     ///< D 键按住
+    bool jump = false;      ///< 本tick按下 K
+    bool dash = false;      ///< 本tick按下 Shift
+};
+
+/**
+ * @struct StepResult
+ * @brief 单个tick产生的事件，由渲染层消费（音效、界面提示、胜负界面）
+ */
+struct StepResult {
+    bool jumped = false;                ///< 玩家起跳
+    bool player_died = false;           ///< 玩家死亡（箭矢或岩浆）
+    bool level_completed = false;       ///< 到达出口并通关
+    bool exit_blocked = false;          ///< 触碰出口但目标未完成
+    bool objectives_changed = false;    ///< 关卡目标进度发生变化
+    QVector<int> collected_elements;    ///< 本tick收集的元素索引
+};
+
+/**
+ * @class SimulationWorld
+ * @brief 游戏模拟世界
+ *
+ * 持有碰撞地图、玩家、箭矢、移动平台和开关门状态，每次 step() 推进
+ * 一个 GAME_TICK。不创建任何窗口控件、不依赖真实时间，也不播放声音，
+ * 相同的关卡与输入序列总能得到相同的结果，可在无显示环境下批量运行。
+ */
+class SimulationWorld
+{
+public:
+    /**
+     * @enum Stage
+     * @brief 单tick内的子系统阶段（用于性能统计）
+     */
+    enum Stage {
+        StagePlatforms = 0,     ///< 移动平台
+        StagePlayer,            ///< 玩家运动
+        StagePlatformCollision, ///< 移动平台碰撞与跟随
+        StageDoors,             ///< 门阻挡
+        StageTraps,             ///< 箭机关发射
+        StageProjectiles,       ///< 箭矢运动与命中
+        StageSwitches,          ///< 开关
+        StageElements,          ///< 收集、水、岩浆与出口
+        StageCount
+    };
+
+    /**
+     * @struct MovingPlatformState
+     * @brief 移动平台运行状态
+     */
+    struct MovingPlatformState {
+        Fx::Point current_pos;      ///< 当前位置（定点）
+        Fx::Point prev_pos;         ///< 上一tick的位置（定点，渲染插值用）
+        PlatformPath path;          ///< 路径与速度曲线（位置由tick数直接求出）
+        quint32 active_stamp = 0;   ///< 最近一次处于活动集时的刷新序号（0为从未活动）
+        EntityId element_index;     ///< 对应的实体（游戏元素索引）
+        bool running = true;        ///< 是否运行（被触发图暂停时停在原地）
+        qint64 paused_tick = 0;     ///< 最近一次暂停时的tick
+        qint64 clock_offset = 0;    ///< 累计暂停的tick数
+
+        QPointF currentPos() const { return current_pos.toPointF(); }
+        QPointF prevPos() const { return prev_pos.toPointF(); }
+
+        /// 路径时钟：扣除暂停时间后的tick数，位置仍是它的闭式函数
+        qint64 clockAt(qint64 tick) const { return (running ? tick : paused_tick) - clock_offset; }
+    };
+
+    /**
+     * @brief 构造空的模拟世界
+     */
+    SimulationWorld();
+
+    /**
+     * @brief 加载关卡：填充碰撞地图并重置全部运行状态
+     * @param levelData 关卡数据（由调用者持有，世界只保存指针）
+     */
+    void loadLevel(LevelData* levelData);
+
+    /**
+     * @brief 重置到当前关卡的初始状态（玩家、箭矢、平台、开关门、目标进度）
+     */
+    void reset();
+
+    /**
+     * @brief 推进一个固定步长
+     * @param input 本tick的输入
+     * @return StepResult 本tick产生的事件
+     */
+    StepResult step(const InputFrame& input);
+
+    // === 状态查询（渲染与回放使用） ===
+
+    /**
+     * @brief 获取玩家
+     * @return player& 玩家引用
+     */
+    player& getPlayer() { return pl; }
+    const player& getPlayer() const { return pl; }
+
+    /**
+     * @brief 获取当前关卡数据
+     * @return LevelData* 关卡数据指针，未加载时为nullptr
+     */
+    LevelData* getLevelData() const { return level_data; }
+
+    const ProjectilePool& getProjectiles() const { return projectiles; }
+    const QVector<MovingPlatformState>& getMovingPlatforms() const { return moving_platforms; }
+    const TriggerGraph& getTriggerGraph() const { return trigger_graph; }
+    const ElementStore& getElementStore() const { return store; }
+
+    /**
+     * @brief 检查元素是否已被收集（O(1)查位）
+     * @param elementIndex 游戏元素索引
+     * @return bool 是否已收集
+     */
+    bool isCollected(int elementIndex) const;
+
+    /**
+     * @brief 检查网格是否为实心方块
+     * @param col 列
+     * @param row 行
+     * @return bool 越界返回false
+     */
+    bool isSolid(int col, int row) const;
+
+    /**
+     * @brief 检查门是否处于关闭状态（未与开关配对的门视为关闭）
+     * @param elementIndex 门元素索引
+     * @return bool 是否关闭（需要绘制）
+     */
+    bool isDoorClosed(int elementIndex) const;
+
+    /**
+     * @brief 查询与矩形所在格子重叠的静态元素（不含移动平台）
+     * @param rect 查询矩形
+     * @param out 输出：升序元素索引，需调用者自行做精确相交判断
+     */
+    void queryElements(const QRectF& rect, QVector<int>& out) const { element_index.query(rect, out); }
+
+    /**
+     * @brief 获取活动区域：以玩家为中心、各方向延伸一屏的矩形
+     *
+     * 只有行程与该区域相交的移动平台和箭机关参与模拟，单屏关卡始终整体处于
+     * 活动区域内。tick开销因此只与玩家附近的内容有关，与关卡总尺寸无关。
+     * @return QRectF 活动区域（像素）
+     */
+    QRectF getActiveRegion() const;
+
+    /**
+     * @brief 获取本tick参与模拟的移动平台（moving_platforms下标，升序）
+     * @return const QVector<int>& 平台下标列表
+     */
+    const QVector<int>& getActivePlatforms() const { return active_platforms; }
+
+    /**
+     * @brief 获取已推进的tick数
+     * @return int tick计数
+     */
+    int getTickCount() const { return tick_counter; }
+
+    /**
+     * @brief 获取上一tick的玩家位置（渲染插值用）
+     * @return QPointF 位置
+     */
+    QPointF getPrevPlayerPos() const { return prev_player_pos; }
+
+    /**
+     * @brief 本局是否已结束（死亡或通关后不再推进）
+     * @return bool 是否结束
+     */
+    bool isFinished() const { return finished; }
+
+    /**
+     * @brief 玩家是否处于水中
+     * @return bool 是否在水中
+     */
+    bool isPlayerInWater() const { return is_in_water; }
+
+    /**
+     * @brief 计算当前模拟状态的哈希（FNV-1a），用于校验回放结果
+     * @return quint64 状态哈希
+     */
+    quint64 computeStateHash() const;
+
+    // === 分阶段计时 ===
+
+    /**
+     * @brief 开关分阶段计时（关闭时 step() 不读取时钟）
+     * @param enabled 是否启用
+     */
+    void setStageTimingEnabled(bool enabled) { stage_timing_enabled = enabled; }
+
+    /**
+     * @brief 清零各阶段累计耗时
+     */
+    void resetStageTimes();
+
+    /**
+     * @brief 获取某阶段累计耗时
+     * @param stage 阶段
+     * @return qint64 纳秒
+     */
+    qint64 getStageTimeNs(Stage stage) const { return stage_time_ns[stage]; }
+
+    /**
+     * @brief 获取阶段名称
+     * @param stage 阶段
+     * @return const char* 名称
+     */
+    static const char* stageName(Stage stage);
+
+private:
+    SimulationWorld(const SimulationWorld&) = delete;
+    SimulationWorld& operator=(const SimulationWorld&) = delete;
+
+    // === 各子系统 ===
+
+    /**
+     * @brief 初始化移动平台状态
+     */
+    void initializeMovingPlatforms();
+
+    /**
+     * @brief 更新移动平台位置
+     */
+    void updateMovingPlatforms();
+
+    /**
+     * @brief 按活动移动平台的当前位置更新平台粗筛并重新排序
+     */
+    void updatePlatformBroadphase();
+
+    /**
+     * @brief 为除移动平台外的所有元素建立静态空间索引（关卡加载时调用）
+     */
+    void buildElementIndex();
+
+    /**
+     * @brief 按移动平台行程与箭机关位置建立分块粒度的活动索引
+     */
+    void buildActivityIndex();
+
+    /**
+     * @brief 根据玩家位置刷新活动平台、活动箭机关与箭矢边界
+     *
+     * 离开活动区域的平台休眠：不再求位置，也从平台粗筛中移除；重新进入时
+     * 按当前tick直接求出位置。
+     */
+    void refreshActiveSet();
+
+    /**
+     * @brief 由开关配对与关卡的逻辑节点定义编译触发图（关卡加载时调用）
+     *
+     * 开关（含压力板）为源节点，门、移动平台与箭机关的 input 属性指向任一
+     * 节点名（开关的 switch_id 或逻辑节点的 id）；没有 input 的门沿用开关配对，
+     * 由全部配对开关的与门驱动。
+     */
+    void buildTriggerGraph();
+
+    /**
+     * @brief 触发图回到初始状态并应用全部输出
+     */
+    void resetTriggers();
+
+    /**
+     * @brief 检查玩家与开关的碰撞并推进触发图
+     *
+     * 只有开关状态变化或定时事件到期时才会求值。
+     */
+    void checkSwitchCollisions();
+
+    /**
+     * @brief 把触发图的输出变化应用到门、平台与箭机关
+     */
+    void applyTriggerChanges();
+
+    /**
+     * @brief 收集玩家扫掠时需要避让的动态障碍物（关闭的门、活动移动平台）
+     */
+    void collectPlayerSolids();
+
+    /**
+     * @brief 检查玩家与移动平台的碰撞
+     */
+    void checkMovingPlatformCollisions();
+
+    /**
+     * @brief 处理玩家跟随移动平台
+     */
+    void handlePlatformFollowing();
+
+    /**
+     * @brief 检查门的碰撞（关闭的门阻挡玩家）
+     * @param playerRect 玩家矩形
+     * @return bool 是否与关闭的门发生碰撞
+     */
+    bool checkDoorCollision(const QRectF& playerRect) const;
+
+    /**
+     * @brief 箭机关按各自的发射间隔发射箭矢
+     */
+    void fireArrowTraps();
+
+    /**
+     * @brief 更新箭矢位置并检测碰撞/出界
+     * @return bool 玩家是否被箭矢击中
+     */
+    bool updateProjectiles();
+
+    /**
+     * @brief 检查矩形覆盖的格子中是否有实心方块（按行位段查询碰撞网格）
+     * @param rect 矩形（越界部分按边缘格子计算）
+     * @return bool 是否有实心方块
+     */
+    bool overlapsSolid(const QRectF& rect) const;
+
+    /**
+     * @brief 检查玩家与游戏元素的碰撞
+     * @param result 本tick的事件输出
+     */
+    void checkGameElementCollisions(StepResult& result);
+
+    /**
+     * @brief 收集游戏物品并更新目标进度
+     * @param elementIndex 游戏元素索引
+     * @param result 本tick的事件输出
+     */
+    void collectItem(int elementIndex, StepResult& result);
+
+    /**
+     * @brief 检查出口是否满足通关条件
+     * @return bool 是否可以通关
+     */
+    bool canCompleteLevel() const;
+
+    // === 状态 ===
+    LevelData* level_data;                          ///< 当前关卡数据
+    ElementStore store;                             ///< 元素组件（实体id即元素索引）
+    player pl;                                      ///< 玩家
+    ProjectilePool projectiles;                     ///< 箭矢投射物
+    QVector<MovingPlatformState> moving_platforms;  ///< 移动平台
+    TriggerGraph trigger_graph;                     ///< 开关、逻辑门与受控对象
+    QVector<EntityId> pressed_plates;               ///< 当前被踩住的压力板
+    SpatialHash activity_index;                     ///< 平台行程与箭机关的分块索引（元素索引）
+    QVector<int> activity_hits;                     ///< 活动索引查询结果缓冲
+    QVector<int> active_platforms;                  ///< 活动移动平台（moving_platforms下标）
+    QVector<int> previous_platforms;                ///< 上次刷新时的活动平台（判断休眠用）
+    quint32 activity_stamp;                         ///< 活动集刷新序号
+    QVector<int> active_traps;                      ///< 活动箭机关（元素索引）
+    QRectF projectile_bounds;                       ///< 箭矢存活范围（关卡外扩50像素与活动区域的交集）
+    QBitArray collected_flags;                      ///< 已收集标记（按标记位索引）
+    int collected_count;                            ///< 已收集的标记位数
+    SpatialHash element_index;                      ///< 静态元素空间索引（元素索引）
+    SweepAndPrune platform_broadphase;              ///< 活动移动平台的排序扫描粗筛（moving_platforms下标）
+    mutable QVector<int> element_hits;              ///< 静态索引查询结果缓冲
+    QVector<int> platform_hits;                     ///< 平台粗筛查询结果缓冲
+    QVector<SolidRect> player_solids;               ///< 本tick玩家扫掠的动态障碍物
+    QPointF prev_player_pos;                        ///< 上一tick的玩家位置
+    bool is_in_water;                               ///< 玩家在水中（减速）
+    bool finished;                                  ///< 本局是否已结束
+    int tick_counter;                               ///< 已推进的tick数
+    bool stage_timing_enabled;                      ///< 是否统计各阶段耗时
+    qint64 stage_time_ns[StageCount];               ///< 各阶段累计耗时（纳秒）
+};
+
+#endif // SIMULATIONWORLD_H
@@ -0,0 +1,300 @@
+/**
+ * @file SoundMixer.cpp
+ * @brief 低延迟音效混音器实现
+ * @author 开发团队
+ * @date 2025-11-27
+ */
+
+#include "SoundMixer.h"
+#include "LogCategories.h"
+#include <QAudioSink>
+#include <QAudioDecoder>
+#include <QAudioBuffer>
+#include <QMediaDevices>
+#include <QIODevice>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+/**
+ * @class SoundMixerStream
+ * @brief 供 QAudioSink 拉取数据的无限长输出流，读取时现场混音
+ */
+class SoundMixerStream : public QIODevice
+{
+public:
+    explicit SoundMixerStream(SoundMixer* mixer) : mixer(mixer) {}
+
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override { return 1 << 16; }
+
+protected:
+    qint64 readData(char* data, qint64 maxSize) override { return mixer->render(data, maxSize); }
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    SoundMixer* mixer;
+};
+
+SoundMixer::SoundMixer(QObject* parent)
+    : QObject(parent)
+    , output_device(QMediaDevices::defaultAudioOutput())
+{
+    if (output_device.isNull()) {
+        qCDebug(lcAudio) << "没有可用的音频输出设备";
+        return;
+    }
+
+    // 优先浮点输出，混音结果无需再转换
+    output_format = output_device.preferredFormat();
+    output_format.setSampleFormat(QAudioFormat::Float);
+    if (!output_device.isFormatSupported(output_format)) {
+        output_format.setSampleFormat(QAudioFormat::Int16);
+        if (!output_device.isFormatSupported(output_format)) {
+            output_format = output_device.preferredFormat();
+        }
+    }
+
+    stream = new SoundMixerStream(this);
+    stream->moveToThread(&audio_thread);
+    audio_thread.setObjectName("SoundMixer");
+    audio_thread.start(QThread::TimeCriticalPriority);
+
+    // 输出对象必须在音频线程中创建
+    QMetaObject::invokeMethod(stream, [this]() {
+        sink = new QAudioSink(output_device, output_format, stream);
+        sink->setBufferSize(output_format.bytesForDuration(OUTPUT_BUFFER_US));
+        stream->open(QIODevice::ReadOnly);
+        sink->start(stream);
+    }, Qt::QueuedConnection);
+}
+
+SoundMixer::~SoundMixer()
+{
+    if (stream) {
+        QMetaObject::invokeMethod(stream, [this]() {
+            if (sink) sink->stop();
+            delete stream;      // sink 是其子对象，一并释放
+            sink = nullptr;
+        }, Qt::BlockingQueuedConnection);
+        stream = nullptr;
+    }
+    audio_thread.quit();
+    audio_thread.wait();
+}
+
+bool SoundMixer::loadClip(int clipId, const QUrl& source, int maxVoices)
+{
+    if (!stream || clipId < 0 || clipId >= MAX_CLIPS || clips[clipId].ready.load()) {
+        return false;
+    }
+
+    // 请求解码为输出格式；后端不支持转换时由 publishClip 自行转换
+    QAudioFormat target = output_format;
+    target.setSampleFormat(QAudioFormat::Float);
+
+    QAudioDecoder* decoder = new QAudioDecoder(this);
+    decoder->setAudioFormat(target);
+    decoder->setSource(source);
+
+    auto pending = std::make_shared<PendingClip>();
+    connect(decoder, &QAudioDecoder::bufferReady, this, [decoder, pending]() {
+        appendBuffer(decoder->read(), *pending);
+    });
+    connect(decoder, &QAudioDecoder::finished, this, [this, decoder, pending, clipId, maxVoices]() {
+        publishClip(clipId, *pending, maxVoices);
+        decoder->deleteLater();
+    });
+    connect(decoder, QOverload<QAudioDecoder::Error>::of(&QAudioDecoder::error), this,
+            [decoder, source](QAudioDecoder::Error) {
+        qCDebug(lcAudio) << "音效解码失败：" << source << decoder->errorString();
+        decoder->deleteLater();
+    });
+    decoder->start();
+    return true;
+}
+
+bool SoundMixer::play(int clipId)
+{
+    if (!stream || clipId < 0 || clipId >= MAX_CLIPS ||
+        !clips[clipId].ready.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    const quint32 head = trigger_head.load(std::memory_order_relaxed);
+    if (head - trigger_tail.load(std::memory_order_acquire) >= TRIGGER_QUEUE_SIZE) {
+        return true;    // 队列已满（音频线程停顿），丢弃这次触发
+    }
+    trigger_queue[head % TRIGGER_QUEUE_SIZE] = clipId;
+    trigger_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+void SoundMixer::appendBuffer(const QAudioBuffer& buffer, PendingClip& pending)
+{
+    const QAudioFormat format = buffer.format();
+    if (!buffer.isValid() || !format.isValid()) return;
+
+    pending.sample_rate = format.sampleRate();
+    pending.channels = format.channelCount();
+
+    const int sampleCount = buffer.sampleCount();
+    const int bytesPerSample = format.bytesPerSample();
+    const char* data = buffer.constData<char>();
+    const int offset = pending.samples.size();
+    pending.samples.resize(offset + sampleCount);
+    for (int i = 0; i < sampleCount; ++i) {
+        pending.samples[offset + i] = format.normalizedSampleValue(data + i * bytesPerSample);
+    }
+}
+
+void SoundMixer::publishClip(int clipId, const PendingClip& pending, int maxVoices)
+{
+    if (pending.channels <= 0 || pending.sample_rate <= 0 || pending.samples.isEmpty()) {
+        qCDebug(lcAudio) << "音效没有可用的PCM数据：" << clipId;
+        return;
+    }
+
+    // 声道映射与线性插值重采样到输出格式（解码器已按输出格式解码时只是复制）
+    const int inChannels = pending.channels;
+    const int outChannels = output_format.channelCount();
+    const qint64 inFrames = pending.samples.size() / inChannels;
+    const qint64 outFrames = inFrames * output_format.sampleRate() / pending.sample_rate;
+    const double step = double(pending.sample_rate) / output_format.sampleRate();
+
+    Clip& clip = clips[clipId];
+    clip.samples.resize(outFrames * outChannels);
+    for (qint64 i = 0; i < outFrames; ++i) {
+        const double pos = i * step;
+        const qint64 i0 = qMin<qint64>(qint64(pos), inFrames - 1);
+        const qint64 i1 = qMin<qint64>(i0 + 1, inFrames - 1);
+        const float t = float(pos - i0);
+        for (int c = 0; c < outChannels; ++c) {
+            float a = 0.0f;
+            float b = 0.0f;
+            if (outChannels == 1) {
+                // 单声道输出：各源声道取平均
+                for (int s = 0; s < inChannels; ++s) {
+                    a += pending.samples[i0 * inChannels + s];
+                    b += pending.samples[i1 * inChannels + s];
+                }
+                a /= inChannels;
+                b /= inChannels;
+            } else {
+                const int s = qMin(c, inChannels - 1);
+                a = pending.samples[i0 * inChannels + s];
+                b = pending.samples[i1 * inChannels + s];
+            }
+            clip.samples[i * outChannels + c] = a + (b - a) * t;
+        }
+    }
+    clip.frames = int(outFrames);
+    clip.max_voices = qBound(1, maxVoices, VOICE_COUNT);
+    clip.ready.store(true, std::memory_order_release);
+}
+
+void SoundMixer::startVoice(int clipId)
+{
+    const Clip& clip = clips[clipId];
+
+    // 统计该音效已占用的声部，同时找出最早开始的声部
+    int sameCount = 0;
+    int oldestSame = -1;
+    int freeVoice = -1;
+    int oldestAny = 0;
+    for (int i = 0; i < VOICE_COUNT; ++i) {
+        const Voice& v = voices[i];
+        if (v.clip < 0) {
+            if (freeVoice < 0) freeVoice = i;
+            continue;
+        }
+        if (v.clip == clipId) {
+            sameCount++;
+            if (oldestSame < 0 || v.serial < voices[oldestSame].serial) oldestSame = i;
+        }
+        if (voices[oldestAny].clip < 0 || v.serial < voices[oldestAny].serial) oldestAny = i;
+    }
+
+    int target;
+    if (sameCount >= clip.max_voices) {
+        target = oldestSame;
+    } else if (freeVoice >= 0) {
+        target = freeVoice;
+    } else {
+        target = oldestAny;
+    }
+
+    Voice& v = voices[target];
+    v.clip = clipId;
+    v.frame = 0;
+    v.serial = next_serial++;
+}
+
+qint64 SoundMixer::render(char* data, qint64 bytes)
+{
+    const int channels = output_format.channelCount();
+    const int bytesPerFrame = output_format.bytesPerFrame();
+    if (bytesPerFrame <= 0) return 0;
+    const int frames = int(bytes / bytesPerFrame);
+    if (frames <= 0) return 0;
+
+    // 处理GUI线程提交的触发请求
+    const quint32 head = trigger_head.load(std::memory_order_acquire);
+    quint32 tail = trigger_tail.load(std::memory_order_relaxed);
+    while (tail != head) {
+        startVoice(trigger_queue[tail % TRIGGER_QUEUE_SIZE]);
+        ++tail;
+    }
+    trigger_tail.store(tail, std::memory_order_release);
+
+    // 混合所有活动声部
+    const int sampleCount = frames * channels;
+    if (mix_buffer.size() < sampleCount) {
+        mix_buffer.resize(sampleCount);
+    }
+    float* mix = mix_buffer.data();
+    std::fill(mix, mix + sampleCount, 0.0f);
+
+    const float volume = master_volume.load(std::memory_order_relaxed);
+    for (Voice& v : voices) {
+        if (v.clip < 0) continue;
+        const Clip& clip = clips[v.clip];
+        const int count = qMin(frames, clip.frames - v.frame);
+        const float* src = clip.samples.constData() + qint64(v.frame) * channels;
+        for (int i = 0; i < count * channels; ++i) {
+            mix[i] += src[i] * volume;
+        }
+        v.frame += count;
+        if (v.frame >= clip.frames) {
+            v.clip = -1;
+        }
+    }
+
+    // 转换为输出格式（限幅到[-1, 1]）
+    switch (output_format.sampleFormat()) {
+    case QAudioFormat::Float: {
+        float* out = reinterpret_cast<float*>(data);
+        for (int i = 0; i < sampleCount; ++i) out[i] = qBound(-1.0f, mix[i], 1.0f);
+        break;
+    }
+    case QAudioFormat::Int16: {
+        qint16* out = reinterpret_cast<qint16*>(data);
+        for (int i = 0; i < sampleCount; ++i) out[i] = qint16(qBound(-1.0f, mix[i], 1.0f) * 32767.0f);
+        break;
+    }
+    case QAudioFormat::Int32: {
+        qint32* out = reinterpret_cast<qint32*>(data);
+        for (int i = 0; i < sampleCount; ++i) out[i] = qint32(qBound(-1.0f, mix[i], 1.0f) * 2147483520.0f);
+        break;
+    }
+    case QAudioFormat::UInt8: {
+        quint8* out = reinterpret_cast<quint8*>(data);
+        for (int i = 0; i < sampleCount; ++i) out[i] = quint8(128 + int(qBound(-1.0f, mix[i], 1.0f) * 127.0f));
+        break;
+    }
+    default:
+        std::fill(data, data + qint64(frames) * bytesPerFrame, 0);
+        break;
+    }
+    return qint64(frames) * bytesPerFrame;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file SoundMixer.h
+ * @brief 低延迟音效混音器：预解码PCM、固定复音数、独立音频线程输出
+ * @author 开发团队
+ * @date 2025-11-27
+ * @version 1.0.0
+ */
+
+#ifndef SOUNDMIXER_H
+#define SOUNDMIXER_H
+
+#include <QObject>
+#include <QThread>
+#include <QVector>
+#include <QUrl>
+#include <QAudioFormat>
+#include <QAudioDevice>
+#include <atomic>
+
+class QAudioSink;
+class QAudioBuffer;
+class SoundMixerStream;
+
+/**
+ * @class SoundMixer
+ * @brief 软件混音器
+ *
+ * 各音效在启动时由 QAudioDecoder 解码为输出格式的浮点PCM（声道数与采样率
+ * 与输出设备一致），之后播放不再访问文件。固定数量的声部在独立的音频线程
+ * 中混合为一路 QAudioSink 输出流，输出缓冲只有几毫秒，触发延迟随之很小。
+ *
+ * play() 在GUI线程调用，通过单生产者/单消费者的无锁环形队列把触发请求交给
+ * 音频线程；声部只由音频线程读写。每种音效有独立的复音上限，超过上限时
+ * 抢占该音效最早开始的声部，没有空闲声部时抢占全局最早的声部。
+ */
+class SoundMixer : public QObject
+{
+    Q_OBJECT
+public:
+    static constexpr int VOICE_COUNT = 16;          ///< 声部数
+    static constexpr int MAX_CLIPS = 8;             ///< 音效种类上限
+    static constexpr int OUTPUT_BUFFER_US = 8000;   ///< 输出缓冲时长（微秒）
+
+    explicit SoundMixer(QObject* parent = nullptr);
+    ~SoundMixer() override;
+
+    /**
+     * @brief 输出设备是否可用
+     * @return bool 是否已建立输出流
+     */
+    bool isAvailable() const { return stream != nullptr; }
+
+    /**
+     * @brief 异步解码一个音效（解码完成后才能播放）
+     * @param clipId 音效编号（0 ~ MAX_CLIPS-1）
+     * @param source 音频文件地址（支持 qrc:/）
+     * @param maxVoices 该音效同时发声的上限
+     * @return bool 是否已开始解码
+     */
+    bool loadClip(int clipId, const QUrl& source, int maxVoices);
+
+    /**
+     * @brief 触发播放（GUI线程调用）
+     * @param clipId 音效编号
+     * @return bool 是否已交给混音器（音效尚未解码完成或输出不可用时返回false）
+     */
+    bool play(int clipId);
+
+    /**
+     * @brief 设置音效音量
+     * @param volume 音量（0.0 ~ 1.0）
+     */
+    void setVolume(float volume) { master_volume.store(volume, std::memory_order_relaxed); }
+
+private:
+    friend class SoundMixerStream;
+
+    /**
+     * @struct Clip
+     * @brief 预解码的音效（ready 置位后只读）
+     */
+    struct Clip {
+        QVector<float> samples;         ///< 交错存储的PCM（输出声道数）
+        int frames = 0;                 ///< 帧数
+        int max_voices = 1;             ///< 复音上限
+        std::atomic<bool> ready{false}; ///< 是否可播放
+    };
+
+    /**
+     * @struct Voice
+     * @brief 声部（仅音频线程访问）
+     */
+    struct Voice {
+        int clip = -1;          ///< 正在播放的音效，-1表示空闲
+        int frame = 0;          ///< 播放位置（帧）
+        quint32 serial = 0;     ///< 开始序号，越小越早
+    };
+
+    /**
+     * @struct PendingClip
+     * @brief 解码中的音效（GUI线程访问）
+     */
+    struct PendingClip {
+        QVector<float> samples; ///< 源格式声道数的交错PCM
+        int sample_rate = 0;    ///< 源采样率
+        int channels = 0;       ///< 源声道数
+    };
+
+    /**
+     * @brief 把解码得到的音频块追加为浮点PCM
+     */
+    static void appendBuffer(const QAudioBuffer& buffer, PendingClip& pending);
+
+    /**
+     * @brief 转换声道数与采样率后发布给音频线程
+     */
+    void publishClip(int clipId, const PendingClip& pending, int maxVoices);
+
+    /**
+     * @brief 音频线程：处理触发队列并混合输出（由输出流的 readData 调用）
+     * @param data 输出缓冲
+     * @param bytes 字节数
+     * @return qint64 写入的字节数
+     */
+    qint64 render(char* data, qint64 bytes);
+
+    /**
+     * @brief 音频线程：为音效分配声部（按复音上限抢占）
+     */
+    void startVoice(int clipId);
+
+    static constexpr int TRIGGER_QUEUE_SIZE = 64;   ///< 触发队列容量（2的幂）
+
+    QAudioDevice output_device;                     ///< 输出设备
+    QAudioFormat output_format;                     ///< 输出格式
+    QThread audio_thread;                           ///< 音频线程
+    QAudioSink* sink = nullptr;                     ///< 输出（属于音频线程）
+    SoundMixerStream* stream = nullptr;             ///< 混音输出流（属于音频线程）
+
+    Clip clips[MAX_CLIPS];                          ///< 预解码音效
+    Voice voices[VOICE_COUNT];                      ///< 声部
+    quint32 next_serial = 0;                        ///< 下一个声部开始序号
+    QVector<float> mix_buffer;                      ///< 混音缓冲
+
+    int trigger_queue[TRIGGER_QUEUE_SIZE];          ///< 触发请求环形队列
+    std::atomic<quint32> trigger_head{0};           ///< 写位置（GUI线程）
+    std::atomic<quint32> trigger_tail{0};           ///< 读位置（音频线程）
+    std::atomic<float> master_volume{1.0f};         ///< 音量
+};
+
+#endif // SOUNDMIXER_H
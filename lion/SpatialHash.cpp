@@ -0,0 +1,81 @@
+/**
+ * @file SpatialHash.cpp
+ * @brief 均匀网格空间哈希实现
+ * @author 开发团队
+ * @date 2025-11-26
+ */
+
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(int cellSize)
+    : cell_size(qMax(1, cellSize))
+    , object_count(0)
+    , current_stamp(0)
+{
+}
+
+void SpatialHash::clear()
+{
+    for (auto it = cells.begin(); it != cells.end(); ++it) {
+        it.value().clear();
+    }
+    object_count = 0;
+}
+
+int SpatialHash::toCell(qreal v) const
+{
+    return static_cast<int>(std::floor(v / cell_size));
+}
+
+void SpatialHash::insert(int id, const QRectF& rect)
+{
+    if (id < 0) return;
+
+    const int x0 = toCell(rect.left());
+    const int x1 = toCell(rect.right());
+    const int y0 = toCell(rect.top());
+    const int y1 = toCell(rect.bottom());
+    for (int cx = x0; cx <= x1; ++cx) {
+        for (int cy = y0; cy <= y1; ++cy) {
+            cells[cellKey(cx, cy)].append(id);
+        }
+    }
+
+    if (id >= visit_stamps.size()) {
+        visit_stamps.resize(id + 1);
+    }
+    object_count++;
+}
+
+void SpatialHash::query(const QRectF& rect, QVector<int>& out) const
+{
+    out.clear();
+    if (object_count == 0) return;
+
+    // 一个对象可能跨多个格子，用递增标记去重，避免每次查询清空标记数组
+    if (++current_stamp == 0) {
+        visit_stamps.fill(0);
+        current_stamp = 1;
+    }
+
+    const int x0 = toCell(rect.left());
+    const int x1 = toCell(rect.right());
+    const int y0 = toCell(rect.top());
+    const int y1 = toCell(rect.bottom());
+    for (int cx = x0; cx <= x1; ++cx) {
+        for (int cy = y0; cy <= y1; ++cy) {
+            auto it = cells.constFind(cellKey(cx, cy));
+            if (it == cells.constEnd()) continue;
+            for (int id : it.value()) {
+                if (visit_stamps[id] == current_stamp) continue;
+                visit_stamps[id] = current_stamp;
+                out.append(id);
+            }
+        }
+    }
+
+    // 升序输出，与按元素顺序线性扫描的处理顺序保持一致
+    std::sort(out.begin(), out.end());
+}
@@ -0,0 +1,79 @@
+/**
+ * @file SpatialHash.h
+ * @brief 均匀网格空间哈希，用于游戏元素的区域查询
+ * @author 开发团队
+ * @date 2025-11-26
+ * @version 1.0.0
+ */
+
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include <QHash>
+#include <QVector>
+#include <QRectF>
+#include "Config.h"
+
+/**
+ * @class SpatialHash
+ * @brief 按固定边长的格子对矩形对象分桶
+ *
+ * 对象以整数id（通常是游戏元素索引）插入其外接矩形覆盖的所有格子，
+ * 查询返回与查询矩形所在格子重叠的对象id（升序、去重），调用者再做
+ * 精确的相交判断。格子只是粗筛，结果是保守的超集。
+ */
+class SpatialHash
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param cellSize 格子边长（像素）
+     */
+    explicit SpatialHash(int cellSize = B0);
+
+    /**
+     * @brief 清空所有对象（保留已分配的桶，适合每tick重建的动态层）
+     */
+    void clear();
+
+    /**
+     * @brief 插入对象
+     * @param id 对象id（非负）
+     * @param rect 对象外接矩形
+     */
+    void insert(int id, const QRectF& rect);
+
+    /**
+     * @brief 查询与矩形所在格子重叠的对象
+     * @param rect 查询矩形
+     * @param out 输出：升序、去重的对象id（会先被清空）
+     */
+    void query(const QRectF& rect, QVector<int>& out) const;
+
+    /**
+     * @brief 检查是否没有任何对象
+     * @return bool 是否为空
+     */
+    bool isEmpty() const { return object_count == 0; }
+
+private:
+    /**
+     * @brief 由格子坐标生成哈希键
+     */
+    static quint64 cellKey(int cx, int cy) {
+        return (quint64(quint32(cx)) << 32) | quint32(cy);
+    }
+
+    /**
+     * @brief 像素坐标转格子坐标（向下取整，支持负坐标）
+     */
+    int toCell(qreal v) const;
+
+    int cell_size;                              ///< 格子边长
+    int object_count;                           ///< 已插入对象数
+    QHash<quint64, QVector<int>> cells;         ///< 格子 -> 对象id列表
+    mutable QVector<quint32> visit_stamps;      ///< 查询去重用的访问标记（按id索引）
+    mutable quint32 current_stamp;              ///< 当前查询的标记值
+};
+
+#endif // SPATIALHASH_H
@@ -3,6 +3,9 @@
 #include <QHBoxLayout>
 #include <QPalette>
 #include <QPixmap>
+#include "TextureCache.h"
+#include "LionAnimation.h"
+#include "Config.h"
 #include <QApplication>
 
 SplashScreen::SplashScreen(QWidget *parent)
@@ -12,6 +15,10 @@ SplashScreen::SplashScreen(QWidget *parent)
     , displayTimer(nullptr)
     , fadeAnimation(nullptr)
 {
+    // 启动画面自身的图片优先解码，其余资源在启动画面显示期间后台并行解码
+    TextureCache::getInstance().preload({":/images/start.png"});
+    preloadAssets();
+
     setupUI();
 
     // 设置显示时间为2.5秒后开始淡出
@@ -52,7 +59,7 @@ void SplashScreen::setupUI()
 
     // 创建图片标签
     imageLabel = new QLabel(this);
-    QPixmap startImage(":/images/start.png");
+    QPixmap startImage = TextureCache::getInstance().pixmap(":/images/start.png");
     if (!startImage.isNull()) {
         // 缩放图片到合适大小
         QPixmap scaledImage = startImage.scaled(400, 300, Qt::KeepAspectRatio, Qt::SmoothTransformation);
@@ -85,6 +92,31 @@ void SplashScreen::setupUI()
 
 }
 
+void SplashScreen::preloadAssets()
+{
+    QStringList paths = {
+        // 菜单与各界面
+        ":/images/menu.jpg",
+        ":/images/title.png",
+        ":/images/button_y.png",
+        ":/images/pickbkg.jpg",
+        ":/images/setting_page.png",
+        // 游戏场景
+        BACK_GROUND1,
+        BACK_GROUND2,
+        BLOCK5,
+        ":/images/vegetable.png",
+        ":/images/door.png",
+        ":/images/archery.png",
+        ":/images/arrow.png",
+        ":/images/moving_platform.png",
+        ":/images/switch.svg"
+    };
+    // 玩家动画帧
+    paths << LionAnimation::framePaths();
+    TextureCache::getInstance().preload(paths);
+}
+
 void SplashScreen::startFadeOut()
 {
     fadeAnimation = new QPropertyAnimation(this, "windowOpacity", this);
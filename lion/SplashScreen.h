@@ -23,6 +23,7 @@ private slots:
 
 private:
     void setupUI();
+    void preloadAssets();   // 在后台线程池中预解码各界面用到的图片
     
     QLabel* imageLabel;
     QLabel* textLabel;
@@ -0,0 +1,86 @@
+/**
+ * @file SweepAndPrune.cpp
+ * @brief 单轴排序扫描粗筛实现
+ * @author 开发团队
+ * @date 2025-11-29
+ */
+
+#include "SweepAndPrune.h"
+#include <algorithm>
+
+SweepAndPrune::SweepAndPrune()
+    : max_width(0)
+{
+}
+
+void SweepAndPrune::clear()
+{
+    entries.clear();
+    slot_of_id.fill(-1);
+    max_width = 0;
+}
+
+void SweepAndPrune::update(int id, const QRectF& rect)
+{
+    if (id < 0) return;
+    if (id >= slot_of_id.size()) {
+        slot_of_id.insert(slot_of_id.size(), id + 1 - slot_of_id.size(), -1);
+    }
+
+    const Entry entry{id, rect.left(), rect.right(), rect.top(), rect.bottom()};
+    int& slot = slot_of_id[id];
+    if (slot < 0) {
+        slot = entries.size();
+        entries.append(entry);
+    } else {
+        entries[slot] = entry;
+    }
+}
+
+void SweepAndPrune::remove(int id)
+{
+    if (id < 0 || id >= slot_of_id.size() || slot_of_id[id] < 0) return;
+
+    // 与末尾交换后删除，顺序由下一次 sort() 恢复
+    const int slot = slot_of_id[id];
+    entries[slot] = entries.last();
+    slot_of_id[entries[slot].id] = slot;
+    entries.removeLast();
+    slot_of_id[id] = -1;
+}
+
+void SweepAndPrune::sort()
+{
+    max_width = 0;
+    for (int i = 0; i < entries.size(); ++i) {
+        const Entry entry = entries[i];
+        int j = i;
+        while (j > 0 && entries[j - 1].min_x > entry.min_x) {
+            entries[j] = entries[j - 1];
+            --j;
+        }
+        entries[j] = entry;
+        max_width = qMax(max_width, entry.max_x - entry.min_x);
+    }
+    for (int i = 0; i < entries.size(); ++i) {
+        slot_of_id[entries[i].id] = i;
+    }
+}
+
+void SweepAndPrune::query(const QRectF& rect, QVector<int>& out) const
+{
+    out.clear();
+    if (entries.isEmpty()) return;
+
+    // 左边界早于 rect.left() - max_width 的对象不可能伸到查询范围内
+    const qreal fromX = rect.left() - max_width;
+    auto it = std::lower_bound(entries.constBegin(), entries.constEnd(), fromX,
+                               [](const Entry& entry, qreal x) { return entry.min_x < x; });
+    for (; it != entries.constEnd() && it->min_x <= rect.right(); ++it) {
+        if (it->max_x < rect.left() || it->min_y > rect.bottom() || it->max_y < rect.top()) continue;
+        out.append(it->id);
+    }
+
+    // 升序输出，与按元素顺序线性扫描的处理顺序保持一致
+    std::sort(out.begin(), out.end());
+}
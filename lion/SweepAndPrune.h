@@ -0,0 +1,83 @@
+/**
+ * @file SweepAndPrune.h
+ * @brief 单轴排序扫描（sweep-and-prune）粗筛，用于每tick移动的矩形对象
+ * @author 开发团队
+ * @date 2025-11-29
+ * @version 1.0.0
+ */
+
+#ifndef SWEEPANDPRUNE_H
+#define SWEEPANDPRUNE_H
+
+#include <QVector>
+#include <QRectF>
+
+/**
+ * @class SweepAndPrune
+ * @brief 按左边界排序的矩形列表
+ *
+ * 对象每tick只移动少许，排序结果在tick之间几乎不变，插入排序接近线性；
+ * 与每tick清空重建的空间哈希相比不需要分桶与去重。查询先二分定位可能
+ * 重叠的区间，再逐个比较X/Y范围，结果为升序的对象id（边界相接也算重叠，
+ * 调用者再做精确判断）。修改后须调用 sort() 再查询。
+ */
+class SweepAndPrune
+{
+public:
+    SweepAndPrune();
+
+    /**
+     * @brief 清空所有对象
+     */
+    void clear();
+
+    /**
+     * @brief 插入对象或更新已有对象的矩形
+     * @param id 对象id（非负）
+     * @param rect 对象外接矩形
+     */
+    void update(int id, const QRectF& rect);
+
+    /**
+     * @brief 移除对象（不存在时忽略）
+     * @param id 对象id
+     */
+    void remove(int id);
+
+    /**
+     * @brief 按左边界重新排序（插入排序，对几乎有序的输入接近线性）
+     */
+    void sort();
+
+    /**
+     * @brief 查询与矩形重叠的对象
+     * @param rect 查询矩形
+     * @param out 输出：升序的对象id（会先被清空）
+     */
+    void query(const QRectF& rect, QVector<int>& out) const;
+
+    /**
+     * @brief 检查是否没有任何对象
+     * @return bool 是否为空
+     */
+    bool isEmpty() const { return entries.isEmpty(); }
+
+private:
+    /**
+     * @struct Entry
+     * @brief 一个对象的外接矩形
+     */
+    struct Entry {
+        int id;
+        qreal min_x;
+        qreal max_x;
+        qreal min_y;
+        qreal max_y;
+    };
+
+    QVector<Entry> entries;         ///< 对象（sort() 后按 min_x 升序）
+    QVector<int> slot_of_id;        ///< 对象id -> entries下标（-1为无）
+    qreal max_width;                ///< 最宽对象的宽度（确定查询的起点）
+};
+
+#endif // SWEEPANDPRUNE_H
@@ -0,0 +1,113 @@
+/**
+ * @file SweptAabb.cpp
+ * @brief 连续碰撞检测实现
+ * @author 开发团队
+ * @date 2025-11-29
+ */
+
+#include "SweptAabb.h"
+#include "CollisionGrid.h"
+
+namespace {
+
+constexpr Fx::Fixed TILE = Fx::fromInt(B0);    ///< 一格的定点边长
+
+/**
+ * @brief 向负无穷取整的整数除法（格子坐标可能为负）
+ */
+int floorDiv(Fx::Fixed value, Fx::Fixed divisor)
+{
+    return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+}
+
+} // namespace
+
+SweepHit SweptAabb::sweepBox(const Fx::Rect& box, Axis axis, Fx::Fixed delta, const Fx::Rect& obstacle)
+{
+    SweepHit result;
+    result.travel = delta;
+    if (delta == 0) return result;
+
+    const bool horizontal = axis == AxisX;
+    const Fx::Fixed boxMin = horizontal ? box.left : box.top;
+    const Fx::Fixed boxMax = horizontal ? box.right : box.bottom;
+    const Fx::Fixed obstacleMin = horizontal ? obstacle.left : obstacle.top;
+    const Fx::Fixed obstacleMax = horizontal ? obstacle.right : obstacle.bottom;
+
+    // 垂直于运动的轴上必须严格重叠，只擦过边或角点不算碰撞
+    if (horizontal ? (box.bottom <= obstacle.top || box.top >= obstacle.bottom)
+                   : (box.right <= obstacle.left || box.left >= obstacle.right)) {
+        return result;
+    }
+
+    // 到障碍物近端面的距离；为负说明起始已重叠或障碍物在身后
+    const Fx::Fixed gap = delta > 0 ? obstacleMin - boxMax : boxMin - obstacleMax;
+    if (gap < 0 || gap >= qAbs(delta)) {
+        return result;
+    }
+
+    result.travel = delta > 0 ? gap : -gap;
+    if (horizontal) {
+        result.normal_x = delta > 0 ? -1 : 1;
+    } else {
+        result.normal_y = delta > 0 ? -1 : 1;
+    }
+    return result;
+}
+
+SweepHit SweptAabb::sweepGrid(const CollisionGrid& grid, const Fx::Rect& box, Axis axis, Fx::Fixed delta)
+{
+    SweepHit best;
+    best.travel = delta;
+
+    // 扫掠范围覆盖的格子（右/下边界恰好落在格线上时不含下一格）
+    Fx::Rect swept = box;
+    if (axis == AxisX) {
+        swept.left = qMin(box.left, box.left + delta);
+        swept.right = qMax(box.right, box.right + delta);
+    } else {
+        swept.top = qMin(box.top, box.top + delta);
+        swept.bottom = qMax(box.bottom, box.bottom + delta);
+    }
+    const int colBegin = floorDiv(swept.left, TILE);
+    const int colEnd = floorDiv(swept.right - 1, TILE);
+    const int rowBegin = floorDiv(swept.top, TILE);
+    const int rowEnd = floorDiv(swept.bottom - 1, TILE);
+    if (!grid.anySolidInRect(colBegin, rowBegin, colEnd, rowEnd)) {
+        return best;
+    }
+
+    for (int row = rowBegin; row <= rowEnd; ++row) {
+        if (!grid.anySolidInRow(row, colBegin, colEnd)) continue;
+        for (int col = colBegin; col <= colEnd; ++col) {
+            if (!grid.isSolid(col, row)) continue;
+            const Fx::Rect tile(col * TILE, row * TILE, (col + 1) * TILE, (row + 1) * TILE);
+            const SweepHit hit = sweepBox(box, axis, delta, tile);
+            if (hit.hit() && qAbs(hit.travel) < qAbs(best.travel)) {
+                best = hit;
+            }
+        }
+    }
+    return best;
+}
+
+SweepHit SweptAabb::sweep(const CollisionGrid* grid, const QVector<SolidRect>* solids,
+                          const Fx::Rect& box, Axis axis, Fx::Fixed delta)
+{
+    SweepHit best;
+    best.travel = delta;
+    if (delta == 0) return best;
+
+    if (grid) {
+        best = sweepGrid(*grid, box, axis, delta);
+    }
+    if (solids) {
+        for (const SolidRect& solid : *solids) {
+            const SweepHit hit = sweepBox(box, axis, delta, solid.rect);
+            if (!hit.hit() || qAbs(hit.travel) >= qAbs(best.travel)) continue;
+            if (solid.one_way && hit.normal_y != -1) continue;
+            best = hit;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file TextureCache.cpp
+ * @brief 全局纹理缓存实现
+ * @author 开发团队
+ * @date 2025-11-27
+ */
+
+#include "TextureCache.h"
+#include "LogCategories.h"
+#include <QCoreApplication>
+#include <QImageReader>
+#include <QtConcurrent/QtConcurrentRun>
+
+TextureCache& TextureCache::getInstance()
+{
+    static TextureCache instance;
+    return instance;
+}
+
+TextureCache::TextureCache()
+{
+    // QPixmap不能晚于QApplication析构，退出前释放
+    if (QCoreApplication::instance()) {
+        QObject::connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit,
+                         [this]() { clear(); });
+    }
+}
+
+void TextureCache::preload(const QStringList& paths)
+{
+    for (const QString& path : paths) {
+        request(path);
+    }
+}
+
+QPixmap TextureCache::pixmap(const QString& path)
+{
+    auto it = pixmaps.constFind(path);
+    if (it != pixmaps.constEnd()) {
+        return it.value();
+    }
+
+    // 只等待该路径自身的解码任务
+    const QImage decoded = request(path).result();
+    QPixmap result = decoded.isNull() ? QPixmap() : QPixmap::fromImage(decoded);
+    pixmaps.insert(path, result);
+    decodes.remove(path);
+    return result;
+}
+
+QImage TextureCache::image(const QString& path)
+{
+    auto it = pixmaps.constFind(path);
+    if (it != pixmaps.constEnd()) {
+        return it.value().toImage();
+    }
+    return request(path).result();
+}
+
+void TextureCache::clear()
+{
+    decode_pool.waitForDone();
+    decodes.clear();
+    pixmaps.clear();
+}
+
+QFuture<QImage> TextureCache::request(const QString& path)
+{
+    auto it = decodes.constFind(path);
+    if (it != decodes.constEnd()) {
+        return it.value();
+    }
+
+    QFuture<QImage> future = QtConcurrent::run(&decode_pool, &TextureCache::decode, path);
+    decodes.insert(path, future);
+    return future;
+}
+
+QImage TextureCache::decode(const QString& path)
+{
+    QImageReader reader(path);
+    QImage image = reader.read();
+    if (image.isNull()) {
+        qCDebug(lcRender) << "纹理加载失败：" << path << reader.errorString();
+        return image;
+    }
+    // 提前转换为预乘格式，GUI线程上转QPixmap时无需再逐像素转换
+    return image.convertToFormat(image.hasAlphaChannel() ? QImage::Format_ARGB32_Premultiplied
+                                                         : QImage::Format_RGB32);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file TextureCache.h
+ * @brief 全局纹理缓存：线程池并行解码、按路径去重、共享QPixmap
+ * @author 开发团队
+ * @date 2025-11-27
+ * @version 1.0.0
+ */
+
+#ifndef TEXTURECACHE_H
+#define TEXTURECACHE_H
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QFuture>
+#include <QThreadPool>
+
+/**
+ * @class TextureCache
+ * @brief 进程级纹理缓存
+ *
+ * 启动画面显示期间调用 preload() 把常用图片交给线程池解码为QImage，
+ * 之后各界面通过 pixmap()/image() 按路径取用：同一路径只解码一次，
+ * 返回的QPixmap隐式共享同一份像素数据。若请求时解码尚未完成，则只等待
+ * 该路径自身的解码任务。
+ *
+ * 公共接口只能在GUI线程调用（QPixmap只能在GUI线程创建），
+ * 线程池任务只负责解码，不访问缓存表。
+ */
+class TextureCache
+{
+public:
+    /**
+     * @brief 获取全局实例
+     * @return TextureCache& 实例
+     */
+    static TextureCache& getInstance();
+
+    /**
+     * @brief 在后台并行解码一组图片（已请求过的路径会被跳过）
+     * @param paths 图片路径（资源路径或文件路径）
+     */
+    void preload(const QStringList& paths);
+
+    /**
+     * @brief 获取共享的QPixmap（未预加载时同步解码）
+     * @param path 图片路径
+     * @return QPixmap 图片，加载失败时为空
+     */
+    QPixmap pixmap(const QString& path);
+
+    /**
+     * @brief 获取解码后的QImage（用于需要再加工的源图，如动画帧）
+     * @param path 图片路径
+     * @return QImage 图片，加载失败时为空
+     */
+    QImage image(const QString& path);
+
+    /**
+     * @brief 清空缓存（等待进行中的解码结束）
+     */
+    void clear();
+
+private:
+    TextureCache();
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    /**
+     * @brief 获取某路径的解码任务，尚未请求时提交到线程池
+     * @param path 图片路径
+     * @return QFuture<QImage> 解码任务
+     */
+    QFuture<QImage> request(const QString& path);
+
+    /**
+     * @brief 解码图片并转换为绘制最快的像素格式（在工作线程执行）
+     * @param path 图片路径
+     * @return QImage 图片
+     */
+    static QImage decode(const QString& path);
+
+    QThreadPool decode_pool;                    ///< 解码线程池
+    QHash<QString, QFuture<QImage>> decodes;    ///< 路径 -> 解码任务（转为QPixmap后移除）
+    QHash<QString, QPixmap> pixmaps;            ///< 路径 -> 共享的QPixmap
+};
+
+#endif // TEXTURECACHE_H
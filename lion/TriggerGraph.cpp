@@ -0,0 +1,312 @@
+/**
+ * @file TriggerGraph.cpp
+ * @brief 触发逻辑图实现
+ * @author 开发团队
+ * @date 2025-11-29
+ */
+
+#include "TriggerGraph.h"
+#include <algorithm>
+
+TriggerGraph::TriggerGraph()
+    : event_seq(0)
+    , current_tick(0)
+{
+}
+
+void TriggerGraph::clear()
+{
+    nodes.clear();
+    order.clear();
+    edges.clear();
+    pending_sinks.clear();
+    input_list.clear();
+    fanout_list.clear();
+    sink_list.clear();
+    dirty.clear();
+    events.clear();
+    changes.clear();
+    event_seq = 0;
+    current_tick = 0;
+}
+
+int TriggerGraph::addNode(TriggerNodeType type, int ticks, int onTicks)
+{
+    Node node;
+    node.type = type;
+    node.ticks = qMax(0, ticks);
+    node.on_ticks = qBound(0, onTicks, node.ticks);
+    nodes.append(node);
+    return nodes.size() - 1;
+}
+
+void TriggerGraph::connect(int from, int to)
+{
+    if (from < 0 || from >= nodes.size() || to < 0 || to >= nodes.size()) return;
+    // 源节点与定时器没有输入
+    if (nodes[to].type == TriggerNodeType::Source || nodes[to].type == TriggerNodeType::Timer) return;
+    edges.append(qMakePair(from, to));
+}
+
+void TriggerGraph::addSink(int node, TriggerSinkKind kind, int entity)
+{
+    if (node < 0 || node >= nodes.size()) return;
+    pending_sinks.append(qMakePair(node, Sink{kind, entity}));
+}
+
+bool TriggerGraph::compile()
+{
+    const int count = nodes.size();
+
+    // Kahn 拓扑排序；同一批就绪的节点按id顺序处理，结果与加入顺序相关而与哈希无关
+    QVector<int> inDegree(count, 0);
+    QVector<QVector<int>> fanout(count);
+    for (const auto& edge : edges) {
+        fanout[edge.first].append(edge.second);
+        inDegree[edge.second]++;
+    }
+    order.clear();
+    order.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (inDegree[i] == 0) order.append(i);
+    }
+    for (int head = 0; head < order.size(); ++head) {
+        for (int to : fanout[order[head]]) {
+            if (--inDegree[to] == 0) order.append(to);
+        }
+    }
+
+    // 环上的节点及其下游排在最后，且不再有输入
+    const bool acyclic = order.size() == count;
+    QVector<bool> sorted(count, false);
+    for (int node : order) sorted[node] = true;
+    for (int i = 0; i < count; ++i) {
+        if (!sorted[i]) order.append(i);
+    }
+    for (int rank = 0; rank < count; ++rank) {
+        nodes[order[rank]].rank = rank;
+    }
+
+    // 输入、扇出与输出对象按节点分段存放（计数 -> 前缀和 -> 填充）
+    QVector<int> inputCount(count, 0);
+    QVector<int> fanoutCount(count, 0);
+    QVector<int> sinkCount(count, 0);
+    for (const auto& edge : edges) {
+        if (!sorted[edge.second]) continue;
+        fanoutCount[edge.first]++;
+        inputCount[edge.second]++;
+    }
+    for (const auto& sink : pending_sinks) {
+        sinkCount[sink.first]++;
+    }
+    int inputOffset = 0;
+    int fanoutOffset = 0;
+    int sinkOffset = 0;
+    for (int i = 0; i < count; ++i) {
+        Node& node = nodes[i];
+        node.input_begin = node.input_end = inputOffset;
+        node.fanout_begin = node.fanout_end = fanoutOffset;
+        node.sink_begin = node.sink_end = sinkOffset;
+        inputOffset += inputCount[i];
+        fanoutOffset += fanoutCount[i];
+        sinkOffset += sinkCount[i];
+    }
+    input_list.fill(-1, inputOffset);
+    fanout_list.fill(-1, fanoutOffset);
+    sink_list.resize(sinkOffset);
+    for (const auto& edge : edges) {
+        if (!sorted[edge.second]) continue;
+        fanout_list[nodes[edge.first].fanout_end++] = edge.second;
+        input_list[nodes[edge.second].input_end++] = edge.first;
+    }
+    for (const auto& sink : pending_sinks) {
+        sink_list[nodes[sink.first].sink_end++] = sink.second;
+    }
+
+    edges.clear();
+    pending_sinks.clear();
+    reset();
+    return acyclic;
+}
+
+void TriggerGraph::reset()
+{
+    dirty.clear();
+    events.clear();
+    changes.clear();
+    event_seq = 0;
+    current_tick = 0;
+
+    // 按拓扑序从头求值一次，输入总是先于使用者确定
+    for (int index : order) {
+        Node& node = nodes[index];
+        node.queued = false;
+        switch (node.type) {
+        case TriggerNodeType::Source:
+            node.value = false;
+            break;
+        case TriggerNodeType::Timer:
+            node.value = timerValue(node, 0);
+            if (node.on_ticks > 0 && node.on_ticks < node.ticks) {
+                const qint64 edge = nextTimerEdge(node, 0);
+                schedule(edge, index, timerValue(node, edge));
+            }
+            break;
+        case TriggerNodeType::Toggle:
+            node.input = combinedInput(node);     // 开局时已为真的输入不算上升沿
+            node.value = false;
+            break;
+        case TriggerNodeType::Delay:
+            node.input = combinedInput(node);     // 视为开局前输入一直保持
+            node.value = node.input;
+            break;
+        case TriggerNodeType::And:
+        case TriggerNodeType::Or:
+            node.value = combinedInput(node);
+            break;
+        }
+        node.target = node.value;
+        for (int i = node.sink_begin; i < node.sink_end; ++i) {
+            changes.append(TriggerSinkChange{sink_list[i].kind, sink_list[i].entity, node.value});
+        }
+    }
+}
+
+void TriggerGraph::setSource(int node, bool value)
+{
+    if (node < 0 || node >= nodes.size() || nodes[node].type != TriggerNodeType::Source) return;
+    if (nodes[node].target == value) return;
+    nodes[node].target = value;
+    enqueue(node);
+}
+
+bool TriggerGraph::advance(qint64 tick)
+{
+    changes.clear();
+    current_tick = tick;
+
+    while (!events.isEmpty() && events.first().tick <= tick) {
+        std::pop_heap(events.begin(), events.end(), eventLater);
+        const Event event = events.takeLast();
+        Node& node = nodes[event.node];
+        node.target = event.value;
+        enqueue(event.node);
+        if (node.type == TriggerNodeType::Timer) {
+            const qint64 edge = nextTimerEdge(node, event.tick);
+            schedule(edge, event.node, timerValue(node, edge));
+        }
+    }
+
+    if (!dirty.isEmpty()) {
+        propagate();
+    }
+    return !changes.isEmpty();
+}
+
+bool TriggerGraph::combinedInput(const Node& node) const
+{
+    if (node.input_begin == node.input_end) return false;
+
+    if (node.type == TriggerNodeType::And) {
+        for (int i = node.input_begin; i < node.input_end; ++i) {
+            if (!nodes[input_list[i]].value) return false;
+        }
+        return true;
+    }
+    for (int i = node.input_begin; i < node.input_end; ++i) {
+        if (nodes[input_list[i]].value) return true;
+    }
+    return false;
+}
+
+void TriggerGraph::setValue(int index, bool value)
+{
+    Node& node = nodes[index];
+    if (node.value == value) return;
+    node.value = value;
+
+    for (int i = node.sink_begin; i < node.sink_end; ++i) {
+        changes.append(TriggerSinkChange{sink_list[i].kind, sink_list[i].entity, value});
+    }
+    for (int i = node.fanout_begin; i < node.fanout_end; ++i) {
+        enqueue(fanout_list[i]);
+    }
+}
+
+void TriggerGraph::enqueue(int index)
+{
+    Node& node = nodes[index];
+    if (node.queued) return;
+    node.queued = true;
+    dirty.append(index);
+    std::push_heap(dirty.begin(), dirty.end(), [this](int a, int b) {
+        return nodes[a].rank > nodes[b].rank;
+    });
+}
+
+void TriggerGraph::schedule(qint64 tick, int node, bool value)
+{
+    events.append(Event{tick, event_seq++, node, value});
+    std::push_heap(events.begin(), events.end(), eventLater);
+}
+
+void TriggerGraph::propagate()
+{
+    // 扇出节点的 rank 总是更大，按 rank 出队即为拓扑序，每个节点只求值一次
+    auto laterRank = [this](int a, int b) { return nodes[a].rank > nodes[b].rank; };
+    while (!dirty.isEmpty()) {
+        std::pop_heap(dirty.begin(), dirty.end(), laterRank);
+        const int index = dirty.takeLast();
+        Node& node = nodes[index];
+        node.queued = false;
+
+        bool value = node.value;
+        switch (node.type) {
+        case TriggerNodeType::Source:
+        case TriggerNodeType::Timer:
+            value = node.target;
+            break;
+        case TriggerNodeType::And:
+        case TriggerNodeType::Or:
+            value = combinedInput(node);
+            break;
+        case TriggerNodeType::Toggle: {
+            const bool input = combinedInput(node);
+            if (input && !node.input) value = !node.value;
+            node.input = input;
+            break;
+        }
+        case TriggerNodeType::Delay: {
+            const bool input = combinedInput(node);
+            if (input != node.input) {
+                node.input = input;
+                if (node.ticks == 0) {
+                    node.target = input;
+                } else {
+                    schedule(current_tick + node.ticks, index, input);
+                }
+            }
+            value = node.target;
+            break;
+        }
+        }
+        setValue(index, value);
+    }
+}
+
+bool TriggerGraph::eventLater(const Event& a, const Event& b)
+{
+    return a.tick != b.tick ? a.tick > b.tick : a.seq > b.seq;
+}
+
+bool TriggerGraph::timerValue(const Node& node, qint64 tick) const
+{
+    if (node.ticks <= 0) return false;
+    return tick % node.ticks < node.on_ticks;
+}
+
+qint64 TriggerGraph::nextTimerEdge(const Node& node, qint64 tick) const
+{
+    const qint64 phase = tick % node.ticks;
+    return phase < node.on_ticks ? tick - phase + node.on_ticks : tick - phase + node.ticks;
+}
@@ -0,0 +1,199 @@
+/**
+ * @file TriggerGraph.h
+ * @brief 编译后的触发逻辑图：开关/压力板/定时器 -> 逻辑门 -> 门/平台/机关
+ * @author 开发团队
+ * @date 2025-11-29
+ * @version 1.0.0
+ */
+
+#ifndef TRIGGERGRAPH_H
+#define TRIGGERGRAPH_H
+
+#include <QVector>
+#include <QPair>
+
+/**
+ * @enum TriggerNodeType
+ * @brief 触发图节点类型
+ */
+enum class TriggerNodeType {
+    Source,     ///< 外部输入（开关、压力板），由 setSource() 驱动
+    Timer,      ///< 周期信号：每 period 个tick中前 on_ticks 个tick为真
+    And,        ///< 全部输入为真（无输入时为假）
+    Or,         ///< 任一输入为真
+    Toggle,     ///< 输入每出现一次上升沿，输出翻转一次
+    Delay       ///< 输出为 ticks 个tick之前的输入
+};
+
+/**
+ * @enum TriggerSinkKind
+ * @brief 触发图输出驱动的对象
+ */
+enum class TriggerSinkKind {
+    Door,       ///< 为真时门打开
+    Platform,   ///< 为真时平台运行，为假时停在原地
+    Trap        ///< 为真时机关按间隔发射
+};
+
+/**
+ * @struct TriggerSinkChange
+ * @brief 一次输出变化
+ */
+struct TriggerSinkChange {
+    TriggerSinkKind kind;
+    int entity;         ///< 被驱动的实体（游戏元素索引）
+    bool value;
+};
+
+/**
+ * @class TriggerGraph
+ * @brief 事件驱动的触发逻辑图
+ *
+ * 关卡加载时用 addNode()/connect()/addSink() 搭建并 compile() 一次，得到
+ * 拓扑序与扇出表。运行时只有源节点变化、或定时器/延迟到期时才求值：
+ * 变化的节点把扇出节点按拓扑序放入待求值队列，每个节点每次传播最多求值
+ * 一次；定时器与延迟的下一次变化放在按tick排序的事件堆中。没有任何变化
+ * 的tick里 advance() 只比较一次堆顶，互锁再多也不产生每tick开销。
+ */
+class TriggerGraph
+{
+public:
+    TriggerGraph();
+
+    /**
+     * @brief 清空全部节点、连线与输出
+     */
+    void clear();
+
+    /**
+     * @brief 添加节点
+     * @param type 节点类型
+     * @param ticks Delay 的延迟tick数；Timer 的周期
+     * @param onTicks Timer 每周期为真的tick数（其他类型忽略）
+     * @return int 节点id
+     */
+    int addNode(TriggerNodeType type, int ticks = 0, int onTicks = 0);
+
+    /**
+     * @brief 连接 from 的输出到 to 的输入
+     */
+    void connect(int from, int to);
+
+    /**
+     * @brief 让节点的输出驱动一个对象
+     */
+    void addSink(int node, TriggerSinkKind kind, int entity);
+
+    /**
+     * @brief 计算拓扑序与扇出表
+     *
+     * 成环的节点及其下游无法排序，它们的输入连线被丢弃（输出保持初始值）。
+     * @return bool 是否无环
+     */
+    bool compile();
+
+    /**
+     * @brief 回到初始状态：源节点为假，全图按拓扑序求值一次
+     *
+     * 之后 sinkChanges() 包含全部输出的初始值。
+     */
+    void reset();
+
+    /**
+     * @brief 设置源节点的值（值未变化时不产生任何求值）
+     */
+    void setSource(int node, bool value);
+
+    /**
+     * @brief 处理到 tick 为止到期的事件并传播本tick的全部变化
+     * @param tick 当前tick
+     * @return bool 是否有输出变化（见 sinkChanges()）
+     */
+    bool advance(qint64 tick);
+
+    /**
+     * @brief 最近一次 reset()/advance() 产生的输出变化（按节点拓扑序）
+     */
+    const QVector<TriggerSinkChange>& sinkChanges() const { return changes; }
+
+    bool value(int node) const { return nodes[node].value; }
+    int nodeCount() const { return nodes.size(); }
+    bool isEmpty() const { return nodes.isEmpty(); }
+
+    /**
+     * @brief 待处理的定时事件数（回放状态校验用）
+     */
+    int pendingEventCount() const { return events.size(); }
+
+private:
+    /**
+     * @struct Node
+     * @brief 节点的结构与运行状态
+     */
+    struct Node {
+        TriggerNodeType type = TriggerNodeType::Source;
+        int ticks = 0;
+        int on_ticks = 0;
+        int rank = 0;               ///< 拓扑序位置
+        int input_begin = 0;        ///< 在 input_list 中的区间
+        int input_end = 0;
+        int fanout_begin = 0;       ///< 在 fanout_list 中的区间
+        int fanout_end = 0;
+        int sink_begin = 0;         ///< 在 sink_list 中的区间
+        int sink_end = 0;
+        bool value = false;         ///< 当前输出
+        bool target = false;        ///< Source/Timer/Delay：下次求值时采用的输出
+        bool input = false;         ///< Toggle/Delay：上一次看到的输入
+        bool queued = false;        ///< 已在待求值队列中
+    };
+
+    /**
+     * @struct Event
+     * @brief 定时器或延迟节点在某个tick的输出变化
+     */
+    struct Event {
+        qint64 tick;
+        quint64 seq;                ///< 同一tick内按加入顺序处理
+        int node;
+        bool value;
+    };
+
+    struct Sink {
+        TriggerSinkKind kind;
+        int entity;
+    };
+
+    /// 节点的组合输入（Toggle/Delay 多输入时按或处理）
+    bool combinedInput(const Node& node) const;
+
+    /// 改变节点输出：记录输出变化并把扇出节点放入待求值队列
+    void setValue(int node, bool value);
+
+    void enqueue(int node);
+    void schedule(qint64 tick, int node, bool value);
+
+    /// 事件堆的比较：更晚的事件排在后面
+    static bool eventLater(const Event& a, const Event& b);
+
+    /// 按拓扑序求值待求值队列中的节点
+    void propagate();
+
+    /// Timer 在 tick 时的输出与下一次变化的tick
+    bool timerValue(const Node& node, qint64 tick) const;
+    qint64 nextTimerEdge(const Node& node, qint64 tick) const;
+
+    QVector<Node> nodes;
+    QVector<int> order;                         ///< 按拓扑序排列的节点
+    QVector<QPair<int, int>> edges;             ///< 编译前的连线（from, to）
+    QVector<QPair<int, Sink>> pending_sinks;    ///< 编译前的输出（node, sink）
+    QVector<int> input_list;                    ///< 按节点分段的输入节点
+    QVector<int> fanout_list;                   ///< 按节点分段的扇出节点
+    QVector<Sink> sink_list;                    ///< 按节点分段的输出对象
+    QVector<int> dirty;                         ///< 待求值节点（按 rank 的小顶堆）
+    QVector<Event> events;                      ///< 定时事件（按 tick, seq 的小顶堆）
+    QVector<TriggerSinkChange> changes;         ///< 本次传播的输出变化
+    quint64 event_seq;                          ///< 事件序号
+    qint64 current_tick;                        ///< 正在处理的tick
+};
+
+#endif // TRIGGERGRAPH_H
@@ -1,30 +1,254 @@
 /**
  * @file main.cpp
  * @brief 应用入口，创建并展示主菜单窗口
+ *
+ * 命令行：
+ * - --replay <file>            以可视方式回放录像
+ * - --replay <file> --bench    无界面基准测试（不创建窗口）
+ * - --iterations <n>           基准测试回放次数（默认20）
+ * - --bench --synthetic-vegetables <n> [--ticks <n>]
+ *                              在含n个青菜的合成关卡上执行脚本输入的基准测试
+ * - --compile-level <file>     把JSON关卡编译为同目录下的.lvlb（可重复指定）
+ * - --profile-out <file>       把每tick各阶段耗时（纳秒）写入CSV文件，游戏中按F3查看统计
  */
 
 #include "menu.h"
 #include "SplashScreen.h"
+#include "GameScene.h"
+#include "Replay.h"
+#include "FrameProfiler.h"
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QLoggingCategory>
+#include <QTextStream>
+
+/**
+ * @brief 注册命令行选项
+ * @param parser 命令行解析器
+ */
+static void addCommandLineOptions(QCommandLineParser& parser)
+{
+    parser.addHelpOption();
+    parser.addOption(QCommandLineOption("replay", "回放录像文件", "file"));
+    parser.addOption(QCommandLineOption("bench", "无界面回放基准测试"));
+    parser.addOption(QCommandLineOption("iterations", "基准测试回放次数", "n", "20"));
+    parser.addOption(QCommandLineOption("synthetic-vegetables", "基准测试使用含n个青菜的合成关卡", "n"));
+    parser.addOption(QCommandLineOption("ticks", "合成关卡基准测试的tick数", "n", "3600"));
+    parser.addOption(QCommandLineOption("compile-level", "把JSON关卡编译为二进制关卡文件（.lvlb）", "file"));
+    parser.addOption(QCommandLineOption("profile-out", "把每tick各阶段耗时写入CSV文件", "file"));
+}
+
+/**
+ * @brief 关卡编译：把命令行指定的JSON关卡逐个编译为.lvlb
+ * @param app 核心应用（不含界面）
+ * @return int 进程退出码，全部成功时为0
+ */
+static int runLevelCompiler(QCoreApplication& app)
+{
+    QCommandLineParser parser;
+    addCommandLineOptions(parser);
+    parser.process(app);
+
+    QTextStream out(stdout);
+    int failures = 0;
+    for (const QString& path : parser.values("compile-level")) {
+        const bool ok = LevelData::compileFile(path);
+        out << (ok ? "compiled:    " : "FAILED:      ") << path
+            << (ok ? " -> " + LevelData::compiledPathFor(path) : QString()) << "\n";
+        if (!ok) failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
+
+/**
+ * @brief 生成合成关卡：底部一排地面，青菜按16像素间距铺满上方空间（可重叠）
+ * @param level 输出关卡
+ * @param vegetableCount 青菜数量
+ */
+static void buildSyntheticLevel(LevelData& level, int vegetableCount)
+{
+    level.setLevelName(QString("synthetic_%1").arg(vegetableCount));
+    for (int x = 0; x < GRID_WIDTH; ++x) {
+        level.setElementAt(x, GRID_HEIGHT - 1, GameElementType::SolidBlock);
+    }
+    level.setPlayerStartPosition(QPointF(B0, (GRID_HEIGHT - 2) * B0));
+
+    const int step = B0 / 2;
+    const int columns = (XSIZE - B0) / step + 1;
+    const int rows = ((GRID_HEIGHT - 2) * B0) / step + 1;
+    for (int i = 0; i < vegetableCount; ++i) {
+        const int col = i % columns;
+        const int row = (i / columns) % rows;
+        level.addGameElement(GameElement(GameElementType::Vegetable, QPointF(col * step, row * step)));
+    }
+
+    LevelObjective objective;
+    objective.objective_type = "collect_vegetables";
+    objective.target_count = vegetableCount;
+    objective.description = "收集所有青菜";
+    level.addObjective(objective);
+}
+
+/**
+ * @brief 生成脚本输入：左右往返奔跑并周期性跳跃
+ * @param ticks tick数
+ * @return QVector<InputFrame> 每tick输入
+ */
+static QVector<InputFrame> buildScriptedInput(int ticks)
+{
+    QVector<InputFrame> frames(ticks);
+    for (int t = 0; t < ticks; ++t) {
+        const bool toRight = (t / 600) % 2 == 0;
+        frames[t].right = toRight;
+        frames[t].left = !toRight;
+        frames[t].jump = t % 45 == 0;
+    }
+    return frames;
+}
+
+/**
+ * @brief 输出基准测试的耗时统计
+ * @param out 输出流
+ * @param result 测试结果
+ */
+static void printBenchTimings(QTextStream& out, const ReplayBenchResult& result)
+{
+    const double seconds = result.elapsed_ns / 1e9;
+    out << "elapsed:     " << QString::number(seconds * 1000.0, 'f', 2) << " ms\n";
+    out << "ticks/sec:   " << QString::number(seconds > 0 ? result.total_ticks / seconds : 0.0, 'f', 0) << "\n";
+    out << "stages (ns/tick, separate profiled run):\n";
+    for (int i = 0; i < SimulationWorld::StageCount; ++i) {
+        const double perTick = result.stage_ticks > 0 ? double(result.stage_ns[i]) / result.stage_ticks : 0.0;
+        out << "  " << QString(SimulationWorld::stageName(static_cast<SimulationWorld::Stage>(i))).leftJustified(12)
+            << QString::number(perTick, 'f', 1) << "\n";
+    }
+}
+
+/**
+ * @brief 合成关卡基准测试（无录像，只检查多轮结果一致）
+ * @param parser 已解析的命令行
+ * @return int 进程退出码
+ */
+static int runSyntheticBenchmark(const QCommandLineParser& parser)
+{
+    QTextStream out(stdout);
+    const int vegetables = qMax(0, parser.value("synthetic-vegetables").toInt());
+    const int ticks = qMax(1, parser.value("ticks").toInt());
+    const int iterations = qMax(1, parser.value("iterations").toInt());
+
+    LevelData level;
+    buildSyntheticLevel(level, vegetables);
+    const ReplayBenchResult result = Replay::runBenchmark(level, buildScriptedInput(ticks), iterations);
+
+    out << "level:       synthetic, " << vegetables << " vegetables\n";
+    out << "ticks:       " << ticks << " x " << result.iterations << "\n";
+    printBenchTimings(out, result);
+    out << "state hash:  " << QString::number(result.final_state_hash, 16)
+        << (result.deterministic ? "  DETERMINISTIC" : "  NONDETERMINISTIC") << "\n";
+    return result.deterministic ? 0 : 1;
+}
+
+/**
+ * @brief 无界面基准测试：重复回放录像并输出性能与结果校验
+ * @param app 核心应用（不含界面）
+ * @return int 进程退出码，状态哈希一致时为0
+ */
+static int runReplayBenchmark(QCoreApplication& app)
+{
+    QCommandLineParser parser;
+    addCommandLineOptions(parser);
+    parser.process(app);
+
+    // 模拟代码中的逐tick调试输出会严重拖慢测试
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    if (parser.isSet("synthetic-vegetables")) {
+        return runSyntheticBenchmark(parser);
+    }
+
+    QTextStream out(stdout);
+    const QString replayPath = parser.value("replay");
+    Replay replay;
+    if (replayPath.isEmpty() || !replay.loadFromFile(replayPath)) {
+        out << "无法加载录像：" << replayPath << "\n";
+        return 2;
+    }
+
+    const int iterations = qMax(1, parser.value("iterations").toInt());
+    const ReplayBenchResult result = Replay::runBenchmark(replay, iterations);
+    if (!result.level_loaded) {
+        out << "无法加载关卡：" << replay.getLevelPath() << "\n";
+        return 2;
+    }
+
+    out << "replay:      " << replayPath << "\n";
+    out << "level:       " << replay.getLevelPath()
+        << (result.level_hash_matches ? "" : "  (level file changed since recording)") << "\n";
+    out << "ticks:       " << replay.getTickCount() << " x " << result.iterations << "\n";
+    printBenchTimings(out, result);
+    out << "state hash:  " << QString::number(result.final_state_hash, 16)
+        << " expected " << QString::number(replay.getFinalStateHash(), 16)
+        << (result.state_hash_matches ? "  MATCH" : "  MISMATCH") << "\n";
+    return result.state_hash_matches ? 0 : 1;
+}
 
 int main(int argc, char *argv[])
 {
+    // 基准测试与关卡编译只需要核心应用，可在无显示环境中运行
+    for (int i = 1; i < argc; ++i) {
+        if (qstrcmp(argv[i], "--bench") == 0) {
+            QCoreApplication app(argc, argv);
+            return runReplayBenchmark(app);
+        }
+        if (qstrcmp(argv[i], "--compile-level") == 0) {
+            QCoreApplication app(argc, argv);
+            return runLevelCompiler(app);
+        }
+    }
+
     QApplication a(argc, argv);
-    
-    // 创建启动画面
+
+    QCommandLineParser parser;
+    addCommandLineOptions(parser);
+    parser.process(a);
+
+    // 逐tick耗时导出（同时用于可视回放，便于在固定输入下对比不同版本）
+    if (parser.isSet("profile-out") && !FrameProfiler::getInstance().openCsv(parser.value("profile-out"))) {
+        return 2;
+    }
+
+    // 可视回放：直接打开游戏场景，关闭场景即退出
+    if (parser.isSet("replay")) {
+        Replay replay;
+        if (!replay.loadFromFile(parser.value("replay"))) {
+            return 2;
+        }
+        GameScene* scene = new GameScene(nullptr);
+        QObject::connect(scene, &GameScene::backToMainMenu, &a, &QApplication::quit);
+        if (!scene->playReplay(replay)) {
+            delete scene;
+            return 2;
+        }
+        scene->show();
+        const int code = a.exec();
+        delete scene;
+        return code;
+    }
+
+    // 创建启动画面（同时开始在后台并行预解码图片）
     SplashScreen* splash = new SplashScreen();
-    
-    // 创建主菜单
+
+    // 创建主菜单（只等待自身用到的几张图片解码完成）
     menu* w = new menu();
-    
+
     // 连接启动画面结束信号到主菜单显示
     QObject::connect(splash, &SplashScreen::finished, [w, splash]() {
         w->show();
         splash->deleteLater();
     });
-    
+
     // 显示启动画面
     splash->show();
-    
+
     return a.exec();
 }
@@ -12,6 +12,7 @@
 #include "HelpPage.h"
 #include "Config.h"
 #include "AudioController.h"
+#include "TextureCache.h"
 #include <QLabel>
 #include <QFileDialog>
 #include <QMessageBox>
@@ -78,7 +79,7 @@ void menu::ui_load(){
     const int startY = 80;
     buttons = new HoverSoundButton*[6]; // 添加Help按钮，共6个按钮
 
-    QPixmap back(":/images/menu.jpg");
+    QPixmap back = TextureCache::getInstance().pixmap(":/images/menu.jpg");
     // 背景按窗口比例平滑缩放，避免失真
     QPixmap scaledback = back.scaled(this->size(), Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
     QPalette palette;
@@ -86,14 +87,14 @@ void menu::ui_load(){
     this->setPalette(palette);
     this->resize(1280, 720);
     //背景
-    QPixmap title(":/images/title.png");
+    QPixmap title = TextureCache::getInstance().pixmap(":/images/title.png");
     QLabel *title_label = new QLabel(this);
     QPixmap scaledtitle = title.scaled(540,300, Qt::KeepAspectRatioByExpanding, Qt::SmoothTransformation);
     title_label->setPixmap(scaledtitle);
     title_label->setGeometry(35, 410, 540, 300);//9:5
     title_label->show();
     //标识
-    QPixmap button(":/images/button_y.png");
+    QPixmap button = TextureCache::getInstance().pixmap(":/images/button_y.png");
     QPixmap scaledbutton = button.scaled(200, 100,
                                          Qt::KeepAspectRatio,
                                          Qt::SmoothTransformation);
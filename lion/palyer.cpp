@@ -1,37 +1,57 @@
 #include "player.h"
 #include "Config.h"
+#include "LogCategories.h"
 #include"LevelData.h"
-#include <QDateTime>
+#include <cmath>
 
-extern int map[GRID_WIDTH][GRID_HEIGHT];
-player::player(QWidget *parent) : animation(new LionAnimation(parent))
+player::player() : animation(nullptr), collisionGrid(nullptr), solidRects(nullptr)
 {
-    x = X, y = Y, h = H, w = W;//初始化角色位置和大小
-    vx = 0, vy = 0; // 初始化速度
+    fx = Fx::fromInt(X), fy = Fx::fromInt(Y), h = H, w = W;//初始化角色位置和大小
     isJump = 0;
-    v0 = 0,t = 0;
+    v0 = 0, h1 = 0;
     isRight = true;
     onGround = false;
     onMovingPlatform = false;
-    platformRelativeX = 0.0;
-    platformRelativeY = 0.0;
+    platformRelativeX = 0;
+    platformRelativeY = 0;
     currentPlatformIndex = -1;
     // 初始化按键与动画状态
     isLeftPress = false;
     isRightPress = false;
     lastAnimType = LionAnimation::None;
-    animation->loadAnimationFrames();
-    moveSpeed = MOVE_SPEED;
+    moveSpeed = Fx::fromInt(MOVE_SPEED);
 
     airDashUsed = false; // +++ 新增：初始化空中冲刺标记
 
     // +++ 新增：初始化冲刺变量
     isDashing = false;
-    dashStartTime = 0;
-    dashSpeed = (int)(MOVE_SPEED * 2.5); // 冲刺速度设为2.5倍
+    dashTicksLeft = 0;
+    dashSpeed = Fx::fromInt(MOVE_SPEED * 5) / 2; // 冲刺速度设为2.5倍
+}
 
-    // 初始显示面向右的静态首帧
-    animation->startIdleRight();
+void player::setAnimation(LionAnimation* anim)
+{
+    animation = anim;
+    lastAnimType = LionAnimation::None;
+    if (animation) {
+        // 初始显示面向右的静态首帧（动画帧已在LionAnimation构造时加载）
+        animation->startIdleRight();
+    }
+}
+
+void player::resetMotion()
+{
+    v0 = 0, h1 = 0;
+    isJump = false;
+    isRight = true;
+    onGround = false;
+    onMovingPlatform = false;
+    platformRelativeX = 0;
+    platformRelativeY = 0;
+    currentPlatformIndex = -1;
+    airDashUsed = false;
+    isDashing = false;
+    dashTicksLeft = 0;
 }
 
 void player::startDash()
@@ -47,7 +67,7 @@ void player::startDash()
     }
 
     isDashing = true;
-    dashStartTime = QDateTime::currentMSecsSinceEpoch();
+    dashTicksLeft = DASH_DURATION_TICKS;
 
     // +++ 新增：如果这次是在空中发起的，标记
     if (isJump) {
@@ -58,122 +78,112 @@ void player::startDash()
     // AudioController::getInstance().playSound(SoundType::Dash);
 }
 
+Fx::Rect player::sweepBox(bool horizontal) const
+{
+    const Fx::Rect box = Fx::Rect::fromPosSize(Fx::Point(fx, fy), Fx::fromInt(w), Fx::fromInt(h));
+    const Fx::Fixed inset = Fx::fromInt(CORNER_INSET);
+    return horizontal ? box.adjusted(0, inset, 0, -inset)
+                      : box.adjusted(inset, 0, -inset, 0);
+}
+
+SweepHit player::moveHorizontal(Fx::Fixed dx)
+{
+    // 世界左右边界
+    dx = qBound(-fx, dx, Fx::fromInt(worldRight() - w) - fx);
+    const SweepHit hit = SweptAabb::sweep(collisionGrid, solidRects, sweepBox(true), SweptAabb::AxisX, dx);
+    fx += hit.travel;
+    return hit;
+}
+
+SweepHit player::moveVertical(Fx::Fixed dy)
+{
+    const SweepHit hit = SweptAabb::sweep(collisionGrid, solidRects, sweepBox(false), SweptAabb::AxisY, dy);
+    fy += hit.travel;
+    return hit;
+}
+
+bool player::probe(int dx, int dy) const
+{
+    const bool horizontal = dx != 0;
+    return SweptAabb::sweep(collisionGrid, solidRects, sweepBox(horizontal),
+                            horizontal ? SweptAabb::AxisX : SweptAabb::AxisY,
+                            Fx::fromInt(horizontal ? dx : dy)).hit();
+}
+
 bool player::is_ground()
 {
-    if(map[(x+5)/B0][(y+H)/B0]!=0||map[(x+w-5)/B0][(y+H)/B0]!=0)
-    {
-        if(map[(x+5)/B0][(y+H)/B0]==1||map[(x+w-5)/B0][(y+H)/B0]==1)
-            return 1;
-    }
-    return 0;
+    // 脚下贴着砖块、关闭的门或移动平台顶面
+    return probe(0, 1);
 }
 bool player::right_touch(){
-    // 检测角色右侧在头部与脚部两个采样点是否与砖块接触
-    int rightCol = (x + w) / B0;           // 角色右侧相邻砖块列
-    int topRow   = (y + 5) / B0;           // 头部偏下采样，避免边界抖动
-    int bottomRow= (y + h - 5) / B0;       // 脚部偏上采样，避免误判台阶边缘
-    if (map[rightCol][topRow]==1|| map[rightCol][bottomRow] == 1)
-        return 1;
-    else
-        return 0;
+    return probe(1, 0);
 }
 bool player::left_touch(){
-    // 检测角色左侧在头部与脚部两个采样点是否与砖块接触
-    int leftCol  = (x - 5) / B0;           // 角色左侧相邻砖块列（留5像素余量）
-    int topRow   = (y + 5) / B0;           // 头部偏下采样
-    int bottomRow= (y + h - 5) / B0;       // 脚部偏上采样
-    if (map[leftCol][topRow] == 1 || map[leftCol][bottomRow] == 1)
-        return 1;
-    else
-        return 0;
+    return probe(-1, 0);
 }
 bool player::head_touch(){
-    // 检测角色头顶左右两个角是否触碰砖块
-    int topRow = y / B0;
-    int leftColCorner  = (x + 5) / B0;
-    int rightColCorner = (x + w - 5) / B0;
-    if (map[leftColCorner][topRow] == 1 || map[rightColCorner][topRow] == 1)
-        return 1;
-    else
-        return 0;
+    return probe(0, -1);
 }
 void player::right()
 {
-    if(!right_touch())
-        x = (x + moveSpeed < XSIZE - w) ? x + moveSpeed : XSIZE - w;
+    moveHorizontal(moveSpeed);
     isRight = true;
-   // qDebug()<<moveSpeed;
-    animation->startRightLoop();
+    if (animation) animation->startRightLoop();
 }
 void player::left()
 {
-    if(!left_touch())
-        x = (x - moveSpeed > 0) ? x - moveSpeed : 0;
+    moveHorizontal(-moveSpeed);
     isRight = false;
-    animation->startLeftLoop();
+    if (animation) animation->startLeftLoop();
 }
 void player::jump()
 {
-    AudioController::getInstance().playSound(SoundType::Jump);
-    // 将目标跳跃高度按上一版的视觉效果回归为约两倍 HEIGHT
-    double targetHeight = HEIGHT * 2.0;
-    v0 = -sqrt(2 * G * targetHeight);
+    // 跳跃音效由渲染层根据模拟事件播放
+    // 目标跳跃高度约为两倍 HEIGHT
+    v0 = JUMP_VELOCITY;
     isJump = 1;
-    animation->startJumpLoop();
+    if (animation) animation->startJumpLoop();
     fall();
 }
 
 void player::fall()
 {
-    // 使用基于实际帧率的时间步长
-    t = GAME_TICK / 1000.0; // 将毫秒转换为秒
-    h1 = v0 * t + G * t * t / 2; // 本帧位移（像素）
+    // 固定步长：SimulationWorld 保证每次调用恰好对应 GAME_TICK 毫秒的模拟时间，
+    // 速度以像素/tick计，本tick位移 = v0 + g/2，全部为定点整数运算
+    h1 = v0 + GRAVITY / 2;
 
-    // 先按位移更新一次，再根据碰撞进行对齐修正
-    int dy = (int)(h1 + 0.5);
-    y += dy;
+    // 连续碰撞：沿位移扫掠，停在首个障碍物的接触处，任意速度都不会穿过薄砖块
+    const SweepHit hit = moveVertical(h1);
 
-    if (v0 > 0) {
-        // 下落：检测脚下碰撞并吸附到砖块顶面
-        if (is_ground()) {
-            int tileRow = (y + H) / B0; // 脚所在的砖块行
-            y = tileRow * B0 - H;       // 顶对齐：砖块顶面减去角色高度
-            v0 = 0;
-            isJump = 0;
-            onGround = true;  // 关键修复：设置onGround状态
-            airDashUsed = false; // +++ 新增：在静态地面落地时，重置空中冲刺
-        }
-    } else {
-        // 上升：检测头顶碰撞并压回到砖块下侧
-        if (head_touch()) {
-            int tileRow = y / B0;       // 头部所在的砖块行
-            y = (tileRow + 1) * B0;     // 底对齐：砖块底面
-            v0 = 0;
-            h1 = 0;
-        }
+    if (hit.normal_y < 0) {
+        // 落在砖块、门或平台顶面
+        v0 = 0;
+        isJump = 0;
+        onGround = true;
+        airDashUsed = false; // 落地时重置空中冲刺
+    } else if (hit.normal_y > 0) {
+        // 头顶撞到障碍物底面
+        v0 = 0;
+        h1 = 0;
     }
 
     // 更新速度（重力）
-    v0 = v0 + G * t;
+    v0 += GRAVITY;
 }
 void player::update()
 {
     if (isDashing) {
-        qint64 now = QDateTime::currentMSecsSinceEpoch();
-        if (now - dashStartTime > DASH_DURATION) {
+        if (dashTicksLeft <= 0) {
             // 冲刺结束
             isDashing = false;
         } else {
-            // 正在冲刺：应用冲刺移动
-            if (isRight && !right_touch()) {
-                x = (x + dashSpeed < XSIZE - w) ? x + dashSpeed : XSIZE - w;
-            } else if (!isRight && !left_touch()) {
-                x = (x - dashSpeed > 0) ? x - dashSpeed : 0;
-            }
+            --dashTicksLeft;
+            // 正在冲刺：应用冲刺移动（扫掠到障碍物为止）
+            moveHorizontal(isRight ? dashSpeed : -dashSpeed);
         }
     }
     // 1. 处理跳跃/下落逻辑
-    // 如果不在移动平台上，检查静态地面；如果在移动平台上，onGround由GameScene设置
+    // 如果不在移动平台上，检查静态地面；如果在移动平台上，onGround由SimulationWorld设置
     if (!onMovingPlatform && !is_ground()) {
         isJump = true;
     }
@@ -184,14 +194,14 @@ void player::update()
     // 2. 处理普通移动逻辑 (仅在不冲刺时生效)
     if (!isDashing) {
         if (isLeftPress && !left_touch()) {
-            x = (x - moveSpeed > 0) ? x - moveSpeed : 0;
+            moveHorizontal(-moveSpeed);
             isRight = false;
-            qDebug() << "角色左移，当前移动速度：" << moveSpeed;
+            LJ_HOT_DEBUG(lcPlayer) << "角色左移，当前移动速度：" << Fx::toReal(moveSpeed);
         }
         if (isRightPress && !right_touch()) {
-            x = (x + moveSpeed < XSIZE - w) ? x + moveSpeed : XSIZE - w;
+            moveHorizontal(moveSpeed);
             isRight = true;
-            qDebug() << "角色右移，当前移动速度：" << moveSpeed;
+            LJ_HOT_DEBUG(lcPlayer) << "角色右移，当前移动速度：" << Fx::toReal(moveSpeed);
         }
     }
 
@@ -200,6 +210,8 @@ void player::update()
 }
 void player::updateAnimationState()
 {
+    if (!animation) return;
+
     LionAnimation::AnimationType newType = LionAnimation::None;
 
     // 优先级：跳跃动画 > 移动动画 > 静止
@@ -238,28 +250,28 @@ void player::updateAnimationState()
         lastAnimType = newType;
     }
 }
-QPixmap player::getCurrentAnimationFrame()
+QRect player::getCurrentAnimationFrame()
 {
-    return animation->getCurrentFrame();
+    return animation ? animation->currentFrameRect() : QRect();
 }
 
 void player::setMoveSpeedScale(double scale)
 {
     if (scale < 0.2) scale = 0.2;
     if (scale > 2.0) scale = 2.0;
-    moveSpeed = qMax(1, (int)(MOVE_SPEED * scale));
+    moveSpeed = qMax(Fx::ONE, Fx::fromReal(MOVE_SPEED * scale));
 }
 
 void player::resetMoveSpeed()
 {
-    moveSpeed = MOVE_SPEED;
+    moveSpeed = Fx::fromInt(MOVE_SPEED);
 }
 
 void player::resetKeyStates()
 {
     isLeftPress = false;
     isRightPress = false;
-    qDebug() << "玩家按键状态已重置";
+    qCDebug(lcPlayer) << "玩家按键状态已重置";
 }
 
 void player::resetAirDash()
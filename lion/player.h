@@ -1,32 +1,42 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 #include "qpixmap.h"
-#include <QSoundEffect>
 #include "LionAnimation.h"
 #include "qdebug.h"
-#include "AudioController.h"
+#include "Config.h"
+#include "CollisionGrid.h"
+#include "SweptAabb.h"
+#include "FixedPoint.h"
 class player
 {
 public:
-    player(QWidget *parent = nullptr);
-    int x;
-    int y;//位置
-    double vx; // X轴速度
-    double vy; // Y轴速度
+    player();
+    Fx::Fixed fx;
+    Fx::Fixed fy;//位置（24.8定点，像素）
     int h;
     int w;//大小
-    int h1;//移动距离
-    double t;//离地时间
-    double v0;//向下的速度
+    Fx::Fixed h1;//本tick竖直移动距离（定点）
+    Fx::Fixed v0;//向下的速度（定点，像素/tick）
     bool isJump;//是否跳跃
     bool isRight;//角色朝向
     bool onGround;//是否在地面上
     bool onMovingPlatform;//是否在移动平台上
-    double platformRelativeX; // 玩家相对于平台的X位置
-    double platformRelativeY; // 玩家相对于平台的Y位置
+    Fx::Fixed platformRelativeX; // 玩家相对于平台的X位置（定点）
+    Fx::Fixed platformRelativeY; // 玩家相对于平台的Y位置（定点）
     int currentPlatformIndex; // 当前所在平台的索引
     int picNum;//现在是动画第几帧
 
+    // 每tick重力引起的速度增量（定点，像素/tick²），由 G 与 GAME_TICK 在编译期换算
+    static constexpr Fx::Fixed GRAVITY = Fx::Fixed(G * GAME_TICK * GAME_TICK * Fx::ONE / 1000000.0 + 0.5);
+    // 起跳速度：上升约两倍 HEIGHT（v² = 2gh，整数开方）
+    static constexpr Fx::Fixed JUMP_VELOCITY = -Fx::Fixed(Fx::isqrt(qint64(2) * GRAVITY * Fx::fromInt(HEIGHT * 2)));
+
+    // 浮点位置（碰撞矩形与渲染用）
+    QPointF pos() const { return QPointF(Fx::toReal(fx), Fx::toReal(fy)); }
+    QRectF rect() const { return QRectF(Fx::toReal(fx), Fx::toReal(fy), w, h); }
+    // 放到整数像素位置
+    void setPixelPos(int px, int py) { fx = Fx::fromInt(px); fy = Fx::fromInt(py); }
+
 public:
     void startDash(); // 触发冲刺的函数
     bool getIsDashing() const { return isDashing; } // 供GameScene判断是否在冲刺
@@ -35,11 +45,19 @@ public:
 private:
     bool airDashUsed;
     bool isDashing;          // 是否正在冲刺
-    qint64 dashStartTime;    // 冲刺开始时间 (ms)
-    int dashSpeed;           // 冲刺速度
-    const qint64 DASH_DURATION = 200; // 冲刺持续时间 (200 ms)
+    int dashTicksLeft;       // 冲刺剩余tick数
+    Fx::Fixed dashSpeed;     // 冲刺速度（定点）
+    const int DASH_DURATION_TICKS = (200 + GAME_TICK - 1) / GAME_TICK; // 冲刺持续时间 (约200 ms)
 public:
-    LionAnimation* animation;
+    LionAnimation* animation; // 动画由渲染层挂接，无界面模拟时为nullptr
+    // 挂接动画控件（不转移所有权）
+    void setAnimation(LionAnimation* anim);
+    // 设置碰撞网格（由关卡数据持有，不转移所有权）
+    void setCollisionGrid(const CollisionGrid* grid) { collisionGrid = grid; }
+    // 设置网格之外的动态障碍物（关闭的门、移动平台；由模拟世界每tick更新，不转移所有权）
+    void setSolidRects(const QVector<SolidRect>* rects) { solidRects = rects; }
+    // 重置速度、跳跃、冲刺与平台状态
+    void resetMotion();
     virtual void left();
     virtual void right();
     void jump();
@@ -50,7 +68,7 @@ public:
     bool getLeftPressed() const { return isLeftPress; }
     bool getRightPressed() const { return isRightPress; }
     void updateAnimationState();
-    QPixmap getCurrentAnimationFrame();
+    QRect getCurrentAnimationFrame();   // 当前帧在动画图集中的源矩形
     virtual bool left_touch();
     virtual bool right_touch();
     bool head_touch();
@@ -65,7 +83,19 @@ private:
     bool isLeftPress;  // 记录左键是否按下
     bool isRightPress; // 记录右键是否按下
     LionAnimation::AnimationType lastAnimType;
-    int moveSpeed;     // 当前移动速度（默认MOVE_SPEED）
+    Fx::Fixed moveSpeed; // 当前移动速度（定点，默认MOVE_SPEED）
+    const CollisionGrid* collisionGrid; // 碰撞网格
+    const QVector<SolidRect>* solidRects; // 动态障碍物
+    static constexpr int CORNER_INSET = 5; // 扫掠包围盒在垂直于运动方向上的收窄量（擦过砖块角时不被卡住）
+    // 扫掠用包围盒：水平移动上下收窄，竖直移动左右收窄
+    Fx::Rect sweepBox(bool horizontal) const;
+    // 沿X/Y轴连续移动，停在首个障碍物的接触处，返回实际位移与法线
+    SweepHit moveHorizontal(Fx::Fixed dx);
+    SweepHit moveVertical(Fx::Fixed dy);
+    // 向某方向移动1像素是否会碰撞（即是否贴着障碍物）
+    bool probe(int dx, int dy) const;
+    // 世界右边界（像素），不足一屏的关卡按一屏计算
+    int worldRight() const { return collisionGrid ? qMax(collisionGrid->getWidth() * B0, XSIZE) : XSIZE; }
 };
 
 #endif // PLAYER_H